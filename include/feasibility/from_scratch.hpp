@@ -333,7 +333,7 @@ namespace NP::Feasibility {
 		for (size_t index = 1; index < safe_ordering.size(); index++) {
 			problem.prec.emplace_back(problem.jobs[safe_ordering[index - 1]].get_id(), problem.jobs[safe_ordering[index]].get_id(), Interval<Time>(), false);
 		}
-		validate_prec_cstrnts<Time>(problem.prec, problem.jobs);
+		validate_prec_cstrnts<Time>(problem.prec, problem.job_ids);
 	}
 }
 
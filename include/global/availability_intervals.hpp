@@ -0,0 +1,134 @@
+#ifndef GLOBAL_AVAILABILITY_INTERVALS_HPP
+#define GLOBAL_AVAILABILITY_INTERVALS_HPP
+
+#include <cassert>
+#include <memory>
+
+#include "interval.hpp"
+#include "global/availability_kernels.hpp"
+
+namespace NP {
+
+	namespace Global {
+
+		// Availability intervals of the cores of a Schedule_state, sorted by core.
+		// Since almost all analyses use only a few cores, the intervals of up to
+		// `inline_capacity` cores are stored inside the object itself (and thus inside
+		// the state), such that the common case needs neither a heap allocation nor
+		// a pointer indirection. More cores fall back to a heap-allocated array.
+		//
+		// The lower and upper bounds are stored in two separate arrays, such that the
+		// comparisons done when merging states run over contiguous data
+		// (see availability_kernels.hpp).
+		template<class Time> class Availability_intervals
+		{
+		public:
+			static constexpr unsigned int inline_capacity = 8;
+
+		private:
+			unsigned int num_cores;
+			unsigned int capacity;
+			// the minima, followed by `capacity` maxima
+			std::unique_ptr<Time[]> heap_bounds;
+			Time inline_mins[inline_capacity];
+			Time inline_maxs[inline_capacity];
+
+			Time* mins()
+			{
+				return heap_bounds ? heap_bounds.get() : inline_mins;
+			}
+
+			Time* maxs()
+			{
+				return heap_bounds ? heap_bounds.get() + capacity : inline_maxs;
+			}
+
+			const Time* mins() const
+			{
+				return heap_bounds ? heap_bounds.get() : inline_mins;
+			}
+
+			const Time* maxs() const
+			{
+				return heap_bounds ? heap_bounds.get() + capacity : inline_maxs;
+			}
+
+			// no accidental copies
+			Availability_intervals(const Availability_intervals& origin) = delete;
+
+		public:
+
+			// no cores yet, call reserve() before adding any
+			Availability_intervals()
+				: num_cores(0)
+				, capacity(inline_capacity)
+			{
+			}
+
+			// n cores that all have availability `init`
+			Availability_intervals(unsigned int n, const Interval<Time>& init)
+				: Availability_intervals()
+			{
+				reserve(n);
+				for (unsigned int i = 0; i < n; i++)
+					emplace_back(init.min(), init.max());
+			}
+
+			// make room for n cores; must be called before any core is added
+			void reserve(unsigned int n)
+			{
+				assert(num_cores == 0);
+				if (n > capacity) {
+					heap_bounds.reset(new Time[2 * n]);
+					capacity = n;
+				}
+			}
+
+			void emplace_back(const Time& min, const Time& max)
+			{
+				assert(num_cores < capacity);
+				set(num_cores++, Interval<Time>(min, max));
+			}
+
+			void set(unsigned int i, const Interval<Time>& availability)
+			{
+				mins()[i] = availability.min();
+				maxs()[i] = availability.max();
+			}
+
+			unsigned int size() const
+			{
+				return num_cores;
+			}
+
+			Interval<Time> operator[](unsigned int i) const
+			{
+				assert(i < num_cores);
+				return Interval<Time>(mins()[i], maxs()[i]);
+			}
+
+			// true if the availability interval of every core contains the one of the same core in other
+			bool contains(const Availability_intervals& other) const
+			{
+				assert(num_cores == other.num_cores);
+				return Availability_kernels::contains(mins(), maxs(), other.mins(), other.maxs(), num_cores);
+			}
+
+			// true if the availability interval of every core intersects the one of the same core in other
+			bool intersects(const Availability_intervals& other) const
+			{
+				assert(num_cores == other.num_cores);
+				return Availability_kernels::intersects(mins(), maxs(), other.mins(), other.maxs(), num_cores);
+			}
+
+			// widen the availability interval of every core to include the one of the same core in other
+			void widen(const Availability_intervals& other)
+			{
+				assert(num_cores == other.num_cores);
+				Availability_kernels::widen(mins(), maxs(), other.mins(), other.maxs(), num_cores);
+			}
+		};
+	}
+}
+
+#endif
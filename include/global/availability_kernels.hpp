@@ -0,0 +1,181 @@
+#ifndef GLOBAL_AVAILABILITY_KERNELS_HPP
+#define GLOBAL_AVAILABILITY_KERNELS_HPP
+
+#include <algorithm>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#include "time.hpp"
+
+namespace NP {
+
+	namespace Global {
+
+		// Element-wise operations on the core availabilities of two states, where core i of
+		// state a is [a_min[i], a_max[i]] and core i of state b is [b_min[i], b_max[i]].
+		// They implement, for all cores at once, the Interval operations used when merging
+		// states: contains(), intersects() and widen().
+		//
+		// The generic versions are plain loops that stop at the first core that fails.
+		// If AVX2 is available (see the USE_AVX2 build option), discrete and dense time
+		// use hand-written kernels that handle four cores per instruction.
+		namespace Availability_kernels {
+
+			template<class Time> bool contains_scalar(const Time* a_min, const Time* a_max,
+				const Time* b_min, const Time* b_max, unsigned int n)
+			{
+				for (unsigned int i = 0; i < n; i++)
+					if (b_min[i] < a_min[i] || a_max[i] < b_max[i])
+						return false;
+				return true;
+			}
+
+			template<class Time> bool intersects_scalar(const Time* a_min, const Time* a_max,
+				const Time* b_min, const Time* b_max, unsigned int n)
+			{
+				const Time eps = Time_model::constants<Time>::epsilon();
+				for (unsigned int i = 0; i < n; i++)
+					if (b_max[i] + eps < a_min[i] || a_max[i] + eps < b_min[i])
+						return false;
+				return true;
+			}
+
+			template<class Time> void widen_scalar(Time* a_min, Time* a_max,
+				const Time* b_min, const Time* b_max, unsigned int n)
+			{
+				for (unsigned int i = 0; i < n; i++) {
+					a_min[i] = std::min(a_min[i], b_min[i]);
+					a_max[i] = std::max(a_max[i], b_max[i]);
+				}
+			}
+
+			// true if every interval of a contains the corresponding interval of b
+			template<class Time> bool contains(const Time* a_min, const Time* a_max,
+				const Time* b_min, const Time* b_max, unsigned int n)
+			{
+				return contains_scalar(a_min, a_max, b_min, b_max, n);
+			}
+
+			// true if every interval of a intersects (or is contiguous with) the corresponding interval of b
+			template<class Time> bool intersects(const Time* a_min, const Time* a_max,
+				const Time* b_min, const Time* b_max, unsigned int n)
+			{
+				return intersects_scalar(a_min, a_max, b_min, b_max, n);
+			}
+
+			// widen every interval of a such that it also covers the corresponding interval of b
+			template<class Time> void widen(Time* a_min, Time* a_max,
+				const Time* b_min, const Time* b_max, unsigned int n)
+			{
+				widen_scalar(a_min, a_max, b_min, b_max, n);
+			}
+
+#ifdef __AVX2__
+			template<> inline bool contains<dtime_t>(const dtime_t* a_min, const dtime_t* a_max,
+				const dtime_t* b_min, const dtime_t* b_max, unsigned int n)
+			{
+				unsigned int i = 0;
+				__m256i violated = _mm256_setzero_si256();
+				for (; i + 4 <= n; i += 4) {
+					__m256i amin = _mm256_loadu_si256((const __m256i*) (a_min + i));
+					__m256i amax = _mm256_loadu_si256((const __m256i*) (a_max + i));
+					__m256i bmin = _mm256_loadu_si256((const __m256i*) (b_min + i));
+					__m256i bmax = _mm256_loadu_si256((const __m256i*) (b_max + i));
+					violated = _mm256_or_si256(violated, _mm256_or_si256(
+						_mm256_cmpgt_epi64(amin, bmin), _mm256_cmpgt_epi64(bmax, amax)));
+				}
+				return _mm256_testz_si256(violated, violated)
+					&& contains_scalar(a_min + i, a_max + i, b_min + i, b_max + i, n - i);
+			}
+
+			template<> inline bool intersects<dtime_t>(const dtime_t* a_min, const dtime_t* a_max,
+				const dtime_t* b_min, const dtime_t* b_max, unsigned int n)
+			{
+				unsigned int i = 0;
+				const __m256i eps = _mm256_set1_epi64x(Time_model::constants<dtime_t>::epsilon());
+				__m256i disjoint = _mm256_setzero_si256();
+				for (; i + 4 <= n; i += 4) {
+					__m256i amin = _mm256_loadu_si256((const __m256i*) (a_min + i));
+					__m256i amax = _mm256_loadu_si256((const __m256i*) (a_max + i));
+					__m256i bmin = _mm256_loadu_si256((const __m256i*) (b_min + i));
+					__m256i bmax = _mm256_loadu_si256((const __m256i*) (b_max + i));
+					disjoint = _mm256_or_si256(disjoint, _mm256_or_si256(
+						_mm256_cmpgt_epi64(amin, _mm256_add_epi64(bmax, eps)),
+						_mm256_cmpgt_epi64(bmin, _mm256_add_epi64(amax, eps))));
+				}
+				return _mm256_testz_si256(disjoint, disjoint)
+					&& intersects_scalar(a_min + i, a_max + i, b_min + i, b_max + i, n - i);
+			}
+
+			template<> inline void widen<dtime_t>(dtime_t* a_min, dtime_t* a_max,
+				const dtime_t* b_min, const dtime_t* b_max, unsigned int n)
+			{
+				unsigned int i = 0;
+				for (; i + 4 <= n; i += 4) {
+					__m256i amin = _mm256_loadu_si256((const __m256i*) (a_min + i));
+					__m256i amax = _mm256_loadu_si256((const __m256i*) (a_max + i));
+					__m256i bmin = _mm256_loadu_si256((const __m256i*) (b_min + i));
+					__m256i bmax = _mm256_loadu_si256((const __m256i*) (b_max + i));
+					// AVX2 has no 64-bit min/max, so select with the comparison masks
+					_mm256_storeu_si256((__m256i*) (a_min + i),
+						_mm256_blendv_epi8(amin, bmin, _mm256_cmpgt_epi64(amin, bmin)));
+					_mm256_storeu_si256((__m256i*) (a_max + i),
+						_mm256_blendv_epi8(amax, bmax, _mm256_cmpgt_epi64(bmax, amax)));
+				}
+				widen_scalar(a_min + i, a_max + i, b_min + i, b_max + i, n - i);
+			}
+
+			template<> inline bool contains<dense_t>(const dense_t* a_min, const dense_t* a_max,
+				const dense_t* b_min, const dense_t* b_max, unsigned int n)
+			{
+				unsigned int i = 0;
+				__m256d violated = _mm256_setzero_pd();
+				for (; i + 4 <= n; i += 4) {
+					__m256d amin = _mm256_loadu_pd(a_min + i);
+					__m256d amax = _mm256_loadu_pd(a_max + i);
+					__m256d bmin = _mm256_loadu_pd(b_min + i);
+					__m256d bmax = _mm256_loadu_pd(b_max + i);
+					violated = _mm256_or_pd(violated, _mm256_or_pd(
+						_mm256_cmp_pd(amin, bmin, _CMP_GT_OQ), _mm256_cmp_pd(bmax, amax, _CMP_GT_OQ)));
+				}
+				return _mm256_movemask_pd(violated) == 0
+					&& contains_scalar(a_min + i, a_max + i, b_min + i, b_max + i, n - i);
+			}
+
+			template<> inline bool intersects<dense_t>(const dense_t* a_min, const dense_t* a_max,
+				const dense_t* b_min, const dense_t* b_max, unsigned int n)
+			{
+				unsigned int i = 0;
+				const __m256d eps = _mm256_set1_pd(Time_model::constants<dense_t>::epsilon());
+				__m256d disjoint = _mm256_setzero_pd();
+				for (; i + 4 <= n; i += 4) {
+					__m256d amin = _mm256_loadu_pd(a_min + i);
+					__m256d amax = _mm256_loadu_pd(a_max + i);
+					__m256d bmin = _mm256_loadu_pd(b_min + i);
+					__m256d bmax = _mm256_loadu_pd(b_max + i);
+					disjoint = _mm256_or_pd(disjoint, _mm256_or_pd(
+						_mm256_cmp_pd(_mm256_add_pd(bmax, eps), amin, _CMP_LT_OQ),
+						_mm256_cmp_pd(_mm256_add_pd(amax, eps), bmin, _CMP_LT_OQ)));
+				}
+				return _mm256_movemask_pd(disjoint) == 0
+					&& intersects_scalar(a_min + i, a_max + i, b_min + i, b_max + i, n - i);
+			}
+
+			template<> inline void widen<dense_t>(dense_t* a_min, dense_t* a_max,
+				const dense_t* b_min, const dense_t* b_max, unsigned int n)
+			{
+				unsigned int i = 0;
+				for (; i + 4 <= n; i += 4) {
+					_mm256_storeu_pd(a_min + i, _mm256_min_pd(_mm256_loadu_pd(a_min + i), _mm256_loadu_pd(b_min + i)));
+					_mm256_storeu_pd(a_max + i, _mm256_max_pd(_mm256_loadu_pd(a_max + i), _mm256_loadu_pd(b_max + i)));
+				}
+				widen_scalar(a_min + i, a_max + i, b_min + i, b_max + i, n - i);
+			}
+#endif
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef GLOBAL_CHECKPOINT_HPP
+#define GLOBAL_CHECKPOINT_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "mapped_file.hpp"
+#include "global/spill.hpp"
+
+namespace NP {
+
+	namespace Global {
+
+		// Layout of a checkpoint of the global analysis (see State_space::write_checkpoint()):
+		//
+		//   the magic string, the format version,
+		//   a fingerprint of the analysed problem and of the analysis options,
+		//   the depth, counters, width statistics and response times,
+		//   whether the front had been spilled to disk,
+		//   the number of nodes of the front, followed by the nodes
+		//   (as written by Schedule_node::write_to(), with their states).
+		//
+		// All values are stored in the native byte order, since a checkpoint is
+		// only meant to be resumed on the machine (or kind of machine) that wrote it.
+		namespace Checkpoint {
+
+			static const char magic[8] = { 'N', 'P', 'C', 'K', 'P', 'T', '\r', '\n' };
+			static const std::uint32_t version = 1;
+
+			// Writes a checkpoint next to path and only replaces the previous
+			// checkpoint at path once it is complete, such that a crash while
+			// writing leaves the previous checkpoint intact.
+			class Writer
+			{
+				std::string path, tmp_path;
+				std::FILE* file;
+
+				// no accidental copies
+				Writer(const Writer& origin) = delete;
+
+			public:
+
+				Writer(const std::string& path)
+					: path(path)
+					, tmp_path(path + ".tmp")
+					, file(std::fopen(tmp_path.c_str(), "wb"))
+				{
+					if (!file)
+						throw std::runtime_error("could not create checkpoint " + tmp_path);
+					write(magic, sizeof(magic));
+					write(&version, sizeof(version));
+				}
+
+				~Writer()
+				{
+					if (file) {
+						std::fclose(file);
+						std::remove(tmp_path.c_str());
+					}
+				}
+
+				void write(const void* data, std::size_t size)
+				{
+					if (std::fwrite(data, 1, size, file) != size)
+						throw std::runtime_error("could not write checkpoint " + tmp_path);
+				}
+
+				void write(const Spill_writer& w)
+				{
+					write(w.data(), w.size());
+				}
+
+				void commit()
+				{
+					bool ok = std::fclose(file) == 0;
+					file = nullptr;
+					if (!ok || std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+						std::remove(tmp_path.c_str());
+						throw std::runtime_error("could not write checkpoint " + path);
+					}
+				}
+			};
+
+			// checks the magic string and the format version at the start of a checkpoint
+			inline void check_header(Spill_reader& r, const std::string& path)
+			{
+				char m[sizeof(magic)];
+				for (char& c : m)
+					c = r.get<char>();
+				if (std::memcmp(m, magic, sizeof(magic)) != 0)
+					throw std::runtime_error(path + " is not a checkpoint");
+				if (r.get<std::uint32_t>() != version)
+					throw std::runtime_error(path + " was written by another version of the analysis");
+			}
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,162 @@
+#ifndef GLOBAL_DECOMPOSITION_HPP
+#define GLOBAL_DECOMPOSITION_HPP
+
+#include <algorithm>
+#include <vector>
+
+#include "problem.hpp"
+#include "feasibility/simple_bounds.hpp"
+
+namespace NP {
+
+	namespace Global {
+
+		// Idle-point decomposition: if every job that may arrive before some time t
+		// certainly finishes by t, and no other job can arrive before t, then all cores
+		// are certainly idle at t, and the jobs before and after t can be analysed
+		// separately. A problem is split into segments of jobs at such points.
+		//
+		// The points found here are only candidates: they rely on a bound on the
+		// finish times that ignores how precedence constraints delay jobs under
+		// contention. The analysis of a segment confirms (or refutes) that its jobs
+		// finish by the start of the next segment (see State_space::explore_segments).
+		template<class Time> class Idle_point_decomposition
+		{
+		public:
+
+			typedef Scheduling_problem<Time> Problem;
+
+			// the jobs of the problem, ordered by earliest arrival
+			std::vector<Job_index> by_arrival;
+			// the segments are [boundaries[k], boundaries[k+1]) in by_arrival
+			std::vector<std::size_t> boundaries;
+
+			Idle_point_decomposition(const Problem& prob)
+				: by_arrival(prob.jobs.size())
+			{
+				for (Job_index i = 0; i < by_arrival.size(); i++)
+					by_arrival[i] = i;
+				std::stable_sort(by_arrival.begin(), by_arrival.end(), [&prob](Job_index a, Job_index b) {
+					return prob.jobs[a].earliest_arrival() < prob.jobs[b].earliest_arrival();
+				});
+				boundaries.push_back(0);
+				find_candidates(prob);
+				boundaries.push_back(by_arrival.size());
+			}
+
+			std::size_t number_of_segments() const
+			{
+				return boundaries.size() - 1;
+			}
+
+			// the time at which segment k must be finished, i.e., the earliest
+			// arrival of the first job of segment k + 1
+			Time idle_point(const Problem& prob, std::size_t k) const
+			{
+				return prob.jobs[by_arrival[boundaries[k + 1]]].earliest_arrival();
+			}
+
+			// the indices (in prob) of the jobs of segment k, in increasing order,
+			// such that the jobs keep their relative order in the segment's problem
+			std::vector<Job_index> segment_jobs(std::size_t k) const
+			{
+				std::vector<Job_index> jobs(by_arrival.begin() + boundaries[k], by_arrival.begin() + boundaries[k + 1]);
+				std::sort(jobs.begin(), jobs.end());
+				return jobs;
+			}
+
+			// the problem made of the jobs of segment k, and of their precedence
+			// constraints and abort actions
+			Problem segment_problem(const Problem& prob, std::size_t k) const
+			{
+				std::vector<Job_index> jobs = segment_jobs(k);
+				std::vector<bool> in_segment(prob.jobs.size(), false);
+				typename Problem::Workload workload;
+				workload.reserve(jobs.size());
+				for (Job_index i : jobs) {
+					const Job<Time>& j = prob.jobs[i];
+					in_segment[i] = true;
+					workload.emplace_back(j.get_job_id(), j.arrival_window(), j.get_all_costs(),
+						j.get_deadline(), j.get_priority(), workload.size(), j.get_task_id());
+				}
+
+				typename Problem::Precedence_constraints prec;
+				for (const auto& p : prob.prec)
+					if (in_segment[p.get_fromIndex()])
+						prec.push_back(p);
+
+				typename Problem::Abort_actions aborts;
+				for (const auto& a : prob.aborts)
+					if (in_segment[index_of(prob, a.get_id())])
+						aborts.push_back(a);
+
+				return Problem{ workload, prec, aborts, prob.num_processors };
+			}
+
+			// merge segment k with segment k + 1
+			void merge(std::size_t k)
+			{
+				boundaries.erase(boundaries.begin() + k + 1);
+			}
+
+		private:
+
+			static Job_index index_of(const Problem& prob, const JobID& id)
+			{
+				return prob.job_ids.index_of(id);
+			}
+
+			// Splits by_arrival after position p if no precedence constraint crosses the
+			// split, and if the jobs since the previous split certainly finish before the
+			// next job may arrive.
+			// For m cores and a work-conserving scheduler, the last job J of a set of jobs
+			// finishes at the latest at r_J + C_J + (W - C_J) / m, where r_J is the latest
+			// time at which J is ready, C_J its cost, and W the total work of the set: while
+			// J is ready but not started, all cores are busy with the other jobs.
+			void find_candidates(const Problem& prob)
+			{
+				const std::size_t n = by_arrival.size();
+				if (n < 2)
+					return;
+
+				auto bounds = Feasibility::compute_simple_bounds(prob);
+				if (bounds.has_precedence_cycle)
+					return;
+
+				std::vector<std::size_t> position(n);
+				for (std::size_t p = 0; p < n; p++)
+					position[by_arrival[p]] = p;
+				// crossing[p] > 0 if some precedence constraint crosses the split after position p
+				std::vector<int> crossing(n + 1, 0);
+				for (const auto& c : prob.prec) {
+					std::size_t a = position[c.get_fromIndex()];
+					std::size_t b = position[c.get_toIndex()];
+					crossing[std::min(a, b)]++;
+					crossing[std::max(a, b)]--;
+				}
+
+				const double m = prob.num_processors;
+				double work = 0;
+				double latest_finish = 0;
+				int open_constraints = 0;
+				for (std::size_t p = 0; p + 1 < n; p++) {
+					const Job<Time>& j = prob.jobs[by_arrival[p]];
+					double cost = j.maximal_exec_time(j.get_min_parallelism());
+					double ready = std::max(j.latest_arrival(), bounds.earliest_pessimistic_start_times[by_arrival[p]]);
+					work += cost * j.get_min_parallelism();
+					latest_finish = std::max(latest_finish, ready + cost - cost * j.get_min_parallelism() / m);
+					open_constraints += crossing[p];
+
+					if (!open_constraints && latest_finish + work / m <= (double)prob.jobs[by_arrival[p + 1]].earliest_arrival()) {
+						boundaries.push_back(p + 1);
+						// the jobs up to p no longer interfere with the next ones
+						work = 0;
+						latest_finish = 0;
+					}
+				}
+			}
+		};
+	}
+}
+
+#endif
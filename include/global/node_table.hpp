@@ -0,0 +1,253 @@
+#ifndef GLOBAL_NODE_TABLE_HPP
+#define GLOBAL_NODE_TABLE_HPP
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#ifdef CONFIG_PARALLEL
+#include <atomic>
+#include <deque>
+#include <memory>
+#include "tbb/enumerable_thread_specific.h"
+#endif
+
+#include "jobs.hpp"
+
+namespace NP {
+
+	namespace Global {
+
+		// Flat open-addressing table (with linear probing) used to find the node
+		// of the next depth that has a given set of scheduled jobs. Every slot
+		// stores the lookup key and a second, independent fingerprint of the set
+		// next to the node pointer, such that nodes whose key merely collides can
+		// be skipped without comparing their sets of scheduled jobs.
+		//
+		// The same slot array is reused for every depth: clear() only bumps the
+		// generation number, and slots of older generations count as empty.
+		// Several nodes may be inserted with the same key.
+		template<class Node> class Node_table
+		{
+			struct Slot {
+				hash_value_t key;
+				hash_value_t fingerprint;
+				Node* node;
+				std::uint32_t generation;
+			};
+
+			// must be a power of two
+			static const std::size_t initial_capacity = 1024;
+
+			std::vector<Slot> slots;
+			std::size_t mask;
+			// 64 - log2(number of slots)
+			unsigned int shift;
+			std::size_t num_used;
+			std::uint32_t generation;
+
+			// the job keys are combinations of shifted fields, so mix all bits into the slot index
+			std::size_t home(hash_value_t key) const
+			{
+				std::uint64_t h = (std::uint64_t) key;
+				h ^= h >> 32;
+				return (std::size_t) ((h * 0x9E3779B97F4A7C15ULL) >> shift);
+			}
+
+			bool is_used(const Slot& slot) const
+			{
+				return slot.generation == generation;
+			}
+
+			void place(hash_value_t key, hash_value_t fingerprint, Node* node)
+			{
+				std::size_t i = home(key);
+				while (is_used(slots[i]))
+					i = (i + 1) & mask;
+				slots[i] = Slot{ key, fingerprint, node, generation };
+			}
+
+			void grow()
+			{
+				std::vector<Slot> old_slots(2 * slots.size(), Slot{ 0, 0, nullptr, 0 });
+				old_slots.swap(slots);
+				std::uint32_t old_generation = generation;
+				mask = slots.size() - 1;
+				shift--;
+				generation = 1;
+				for (const Slot& slot : old_slots)
+					if (slot.generation == old_generation)
+						place(slot.key, slot.fingerprint, slot.node);
+			}
+
+		public:
+
+			Node_table()
+				: slots(initial_capacity, Slot{ 0, 0, nullptr, 0 })
+				, mask(initial_capacity - 1)
+				, shift(64 - 10)
+				, num_used(0)
+				, generation(1)
+			{
+			}
+
+			void insert(hash_value_t key, hash_value_t fingerprint, Node* node)
+			{
+				// keep the load factor below 1/2 such that probe sequences stay short
+				if (2 * (num_used + 1) > slots.size())
+					grow();
+				place(key, fingerprint, node);
+				num_used++;
+			}
+
+			// Returns the node most recently inserted with the given key and fingerprint
+			// for which accept(node) holds, or nullptr if there is no such node.
+			template<class Accept>
+			Node* find(hash_value_t key, hash_value_t fingerprint, Accept accept) const
+			{
+				Node* found = nullptr;
+				for (std::size_t i = home(key); is_used(slots[i]); i = (i + 1) & mask) {
+					const Slot& slot = slots[i];
+					if (slot.key == key && slot.fingerprint == fingerprint && accept(slot.node))
+						found = slot.node;
+				}
+				return found;
+			}
+
+			// forget all nodes, but keep the slot array for the next depth
+			void clear()
+			{
+				num_used = 0;
+				if (++generation == 0) {
+					// the generation counter wrapped around, so old slots could look used again
+					for (Slot& slot : slots)
+						slot.generation = 0;
+					generation = 1;
+				}
+			}
+
+			std::size_t size() const
+			{
+				return num_used;
+			}
+		};
+
+#ifdef CONFIG_PARALLEL
+		// Lock-free table used by the parallel explorer to find (or create) the node
+		// of the next depth that has a given set of scheduled jobs.
+		// Every bucket is an atomic pointer to a list of entries, and new entries are
+		// pushed to the front of the list with a compare-and-swap. Entries are never
+		// removed while a depth is explored, so readers can walk the lists without locks.
+		// The entries are stored in per-thread deques, and clear() (which must not run
+		// concurrently with anything else) recycles them and resizes the bucket array
+		// for the number of nodes of the depth that was just built.
+		template<class Node> class Concurrent_node_table
+		{
+			struct Entry {
+				hash_value_t key;
+				hash_value_t fingerprint;
+				Node* node;
+				Entry* next;
+			};
+
+			static const std::size_t initial_capacity = 1024;
+
+			std::unique_ptr<std::atomic<Entry*>[]> buckets;
+			std::size_t num_buckets;
+			// 64 - log2(num_buckets)
+			unsigned int shift;
+			tbb::enumerable_thread_specific<std::deque<Entry>> entries;
+
+			std::size_t home(hash_value_t key) const
+			{
+				std::uint64_t h = (std::uint64_t) key;
+				h ^= h >> 32;
+				return (std::size_t) ((h * 0x9E3779B97F4A7C15ULL) >> shift);
+			}
+
+			// the most recent node in [from, until) with this key and fingerprint that matches
+			template<class Matches>
+			static Node* scan(const Entry* from, const Entry* until,
+				hash_value_t key, hash_value_t fingerprint, Matches& matches)
+			{
+				for (const Entry* e = from; e != until; e = e->next)
+					if (e->key == key && e->fingerprint == fingerprint && matches(e->node))
+						return e->node;
+				return nullptr;
+			}
+
+			void allocate_buckets(std::size_t n)
+			{
+				std::size_t new_num_buckets = initial_capacity;
+				shift = 64 - 10;
+				while (new_num_buckets < n) {
+					new_num_buckets *= 2;
+					shift--;
+				}
+				if (!buckets || new_num_buckets != num_buckets)
+					buckets.reset(new std::atomic<Entry*>[new_num_buckets]);
+				num_buckets = new_num_buckets;
+				for (std::size_t i = 0; i < num_buckets; i++)
+					buckets[i].store(nullptr, std::memory_order_relaxed);
+			}
+
+		public:
+
+			Concurrent_node_table()
+				: num_buckets(0)
+			{
+				allocate_buckets(initial_capacity);
+			}
+
+			// add a node without checking whether it is already there
+			void insert(hash_value_t key, hash_value_t fingerprint, Node* node)
+			{
+				std::atomic<Entry*>& head = buckets[home(key)];
+				Entry& e = entries.local().emplace_back(Entry{ key, fingerprint, node, head.load(std::memory_order_relaxed) });
+				while (!head.compare_exchange_weak(e.next, &e, std::memory_order_release, std::memory_order_relaxed));
+			}
+
+			// Returns the most recent node with the given key and fingerprint for which
+			// matches(node) holds. If there is none, create() is called to make one, which
+			// is inserted and returned. If another thread inserted a matching node in the
+			// meantime, that node is returned instead and the created one is given to discard().
+			template<class Matches, class Create, class Discard>
+			Node* find_or_insert(hash_value_t key, hash_value_t fingerprint,
+				Matches matches, Create create, Discard discard)
+			{
+				std::atomic<Entry*>& head = buckets[home(key)];
+				Entry* seen = head.load(std::memory_order_acquire);
+				if (Node* found = scan(seen, nullptr, key, fingerprint, matches))
+					return found;
+
+				std::deque<Entry>& local_entries = entries.local();
+				Entry& e = local_entries.emplace_back(Entry{ key, fingerprint, create(), seen });
+				while (!head.compare_exchange_weak(e.next, &e, std::memory_order_acq_rel, std::memory_order_acquire)) {
+					// other threads pushed entries in front of the ones we have seen already
+					if (Node* found = scan(e.next, seen, key, fingerprint, matches)) {
+						discard(e.node);
+						local_entries.pop_back();
+						return found;
+					}
+					seen = e.next;
+				}
+				return e.node;
+			}
+
+			// forget all nodes (not thread-safe)
+			void clear()
+			{
+				std::size_t num_entries = 0;
+				for (std::deque<Entry>& local_entries : entries) {
+					num_entries += local_entries.size();
+					local_entries.clear();
+				}
+				// the next depth likely has about as many nodes as this one
+				allocate_buckets(2 * num_entries);
+			}
+		};
+#endif
+	}
+}
+
+#endif
@@ -0,0 +1,194 @@
+#ifndef GLOBAL_PERIODIC_HPP
+#define GLOBAL_PERIODIC_HPP
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <tuple>
+#include <vector>
+
+#include "problem.hpp"
+#include "index_set.hpp"
+#include "global/state_space_data.hpp"
+
+namespace NP {
+
+	namespace Global {
+
+		// Job sets unrolled over several hyperperiods of periodic tasks: every job
+		// that is not in the last hyperperiod has a counterpart one hyperperiod later,
+		// i.e., the job of the same task that arrives exactly one hyperperiod later,
+		// with the same costs, and with its deadline and priority shifted by the
+		// same amount as all other jobs. The exploration can then recognise a front
+		// that is (contained in) an earlier front shifted by one hyperperiod
+		// (see State_space::check_periodic_front()).
+		//
+		// If the jobs do not repeat exactly, or have abort actions, is_periodic() is false.
+		template<class Time> class Periodic_jobs
+		{
+			typedef Scheduling_problem<Time> Problem;
+			typedef Index_set Job_set;
+
+			Time hyperperiod;
+			bool periodic;
+			// counterpart one hyperperiod later / earlier (none if there is none)
+			std::vector<Job_index> later, earlier;
+			// the jobs without an earlier counterpart
+			std::vector<Job_index> first;
+			// all jobs ordered by earliest arrival (i.e., every job after its earlier counterpart)
+			std::vector<Job_index> by_arrival;
+
+		public:
+
+			static constexpr Job_index none = (Job_index)-1;
+
+			Periodic_jobs(const Problem& prob, Time hyperperiod)
+				: hyperperiod(hyperperiod)
+				, periodic(false)
+				, later(prob.jobs.size(), none)
+				, earlier(prob.jobs.size(), none)
+				, by_arrival(prob.jobs.size())
+			{
+				for (Job_index i = 0; i < by_arrival.size(); i++)
+					by_arrival[i] = i;
+				std::stable_sort(by_arrival.begin(), by_arrival.end(), [&prob](Job_index a, Job_index b) {
+					return prob.jobs[a].earliest_arrival() < prob.jobs[b].earliest_arrival();
+				});
+				periodic = hyperperiod > 0 && prob.aborts.empty() && match_counterparts(prob)
+					&& match_precedence_constraints(prob);
+				if (!periodic)
+					return;
+				for (Job_index j = 0; j < earlier.size(); j++)
+					if (earlier[j] == none)
+						first.push_back(j);
+			}
+
+			bool is_periodic() const
+			{
+				return periodic;
+			}
+
+			Time get_hyperperiod() const
+			{
+				return hyperperiod;
+			}
+
+			// number of scheduling decisions per hyperperiod
+			std::size_t jobs_per_period() const
+			{
+				return first.size();
+			}
+
+			Job_index earlier_counterpart(Job_index j) const
+			{
+				return earlier[j];
+			}
+
+			const std::vector<Job_index>& earlier_counterparts() const
+			{
+				return earlier;
+			}
+
+			const std::vector<Job_index>& jobs_by_arrival() const
+			{
+				return by_arrival;
+			}
+
+			// The set of jobs that is scheduled one hyperperiod after 'scheduled' (i.e., the
+			// later counterparts of the jobs in 'scheduled' and all jobs of the first
+			// hyperperiod), and the lookup key of a node with this set. Returns false if some
+			// job in 'scheduled' has no later counterpart.
+			bool shift(const Job_set& scheduled, const State_space_data<Time>& data,
+				Job_set& shifted, hash_value_t& key) const
+			{
+				key = 0;
+				for (Job_index j : first) {
+					shifted.add(j);
+					key ^= data.job_key(data.jobs[j]);
+				}
+				const auto& words = scheduled.words();
+				for (std::size_t w = 0; w < words.size(); w++)
+					for (unsigned int b = 0; b < 64; b++)
+						if (words[w] & (((uint64_t)1) << b)) {
+							Job_index l = later[64 * w + b];
+							if (l == none)
+								return false;
+							shifted.add(l);
+							key ^= data.job_key(data.jobs[l]);
+						}
+				return true;
+			}
+
+		private:
+
+			bool match_counterparts(const Problem& prob)
+			{
+				std::map<std::pair<unsigned long, Time>, Job_index> by_task_and_arrival;
+				for (Job_index j = 0; j < prob.jobs.size(); j++) {
+					const Job<Time>& job = prob.jobs[j];
+					if (!by_task_and_arrival.emplace(std::make_pair(job.get_task_id(), job.earliest_arrival()), j).second)
+						return false;
+				}
+
+				bool first_pair = true;
+				Time priority_shift = 0;
+				std::map<unsigned long, long> job_id_shift;
+				std::size_t num_first = 0, num_last = 0;
+				for (Job_index j = 0; j < prob.jobs.size(); j++) {
+					const Job<Time>& job = prob.jobs[j];
+					auto it = by_task_and_arrival.find(std::make_pair(job.get_task_id(), job.earliest_arrival() + hyperperiod));
+					if (it == by_task_and_arrival.end()) {
+						num_last++;
+						continue;
+					}
+					const Job<Time>& next = prob.jobs[it->second];
+					if (next.latest_arrival() != job.latest_arrival() + hyperperiod
+						|| next.get_all_costs() != job.get_all_costs()
+						|| next.get_deadline() != job.get_deadline() + hyperperiod)
+						return false;
+					// the priority order and the tie-breaks among the later counterparts
+					// must be those among the jobs
+					if (first_pair)
+						priority_shift = next.get_priority() - job.get_priority();
+					else if (next.get_priority() - job.get_priority() != priority_shift)
+						return false;
+					first_pair = false;
+					long id_shift = (long)next.get_job_id() - (long)job.get_job_id();
+					if (job_id_shift.emplace(job.get_task_id(), id_shift).first->second != id_shift)
+						return false;
+					later[j] = it->second;
+					earlier[it->second] = j;
+				}
+				for (Job_index j = 0; j < prob.jobs.size(); j++)
+					if (earlier[j] == none)
+						num_first++;
+				// the pattern must repeat at least once
+				return num_first == num_last && num_first < prob.jobs.size();
+			}
+
+			// the constraints among the later counterparts must be the shifted
+			// constraints among the jobs
+			bool match_precedence_constraints(const Problem& prob) const
+			{
+				typedef std::tuple<Job_index, Job_index, Time, Time, bool> Constraint;
+				std::set<Constraint> constraints;
+				for (const auto& c : prob.prec)
+					constraints.emplace(c.get_fromIndex(), c.get_toIndex(), c.get_minsus(), c.get_maxsus(), c.should_signal_at_completion());
+				for (const auto& c : prob.prec) {
+					Job_index from = c.get_fromIndex(), to = c.get_toIndex();
+					bool shifted = later[from] != none && later[to] != none;
+					bool unshifted = earlier[from] != none && earlier[to] != none;
+					if (!shifted && !unshifted)
+						return false;
+					if (shifted && !constraints.count(Constraint(later[from], later[to], c.get_minsus(), c.get_maxsus(), c.should_signal_at_completion())))
+						return false;
+					if (unshifted && !constraints.count(Constraint(earlier[from], earlier[to], c.get_minsus(), c.get_maxsus(), c.should_signal_at_completion())))
+						return false;
+				}
+				return true;
+			}
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,129 @@
+#ifndef GLOBAL_SORTED_STATES_HPP
+#define GLOBAL_SORTED_STATES_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
+
+namespace NP {
+
+	namespace Global {
+
+		// The states of a Schedule_node, sorted by earliest finish time (states with
+		// the same earliest finish time are kept in the order in which they were added).
+		// Since most nodes have only a few states, up to `inline_capacity` references
+		// are stored inside the object itself, such that the common case needs no heap
+		// allocation, and the states are iterated over contiguous memory. More states
+		// fall back to a heap-allocated array that grows geometrically.
+		template<class State> class Sorted_states
+		{
+		public:
+			static constexpr unsigned int inline_capacity = 4;
+
+			typedef State* const* const_iterator;
+			typedef State** iterator;
+
+		private:
+			std::size_t num_states;
+			std::size_t capacity;
+			std::unique_ptr<State*[]> heap_refs;
+			State* inline_refs[inline_capacity];
+
+			State** data()
+			{
+				return heap_refs ? heap_refs.get() : inline_refs;
+			}
+
+			State* const* data() const
+			{
+				return heap_refs ? heap_refs.get() : inline_refs;
+			}
+
+			// no accidental copies
+			Sorted_states(const Sorted_states& origin) = delete;
+
+		public:
+
+			Sorted_states()
+				: num_states(0)
+				, capacity(inline_capacity)
+			{
+			}
+
+			std::size_t size() const
+			{
+				return num_states;
+			}
+
+			bool empty() const
+			{
+				return num_states == 0;
+			}
+
+			iterator begin()
+			{
+				return data();
+			}
+
+			iterator end()
+			{
+				return data() + num_states;
+			}
+
+			const_iterator begin() const
+			{
+				return data();
+			}
+
+			const_iterator end() const
+			{
+				return data() + num_states;
+			}
+
+			// the first state that becomes available at or after t
+			template<class Time> iterator lower_bound(Time t)
+			{
+				return std::lower_bound(begin(), end(), t, [](const State* s, Time t) {
+					return s->earliest_finish_time() < t;
+				});
+			}
+
+			// add s after the states that do not become available later than s
+			void insert(State* s)
+			{
+				if (num_states == capacity) {
+					std::unique_ptr<State*[]> grown(new State*[2 * capacity]);
+					std::copy(begin(), end(), grown.get());
+					heap_refs = std::move(grown);
+					capacity *= 2;
+				}
+				iterator pos = std::upper_bound(begin(), end(), s, [](const State* s, const State* t) {
+					return s->earliest_finish_time() < t->earliest_finish_time();
+				});
+				std::copy_backward(pos, end(), end() + 1);
+				*pos = s;
+				num_states++;
+			}
+
+			// remove the state at pos (without releasing it); returns the position of the next state
+			iterator erase(iterator pos)
+			{
+				assert(pos >= begin() && pos < end());
+				std::copy(pos + 1, end(), pos);
+				num_states--;
+				return pos;
+			}
+
+			// the state at pos became available earlier: move it back to its place in the order
+			void restore_order(iterator pos)
+			{
+				iterator to = std::upper_bound(begin(), pos, *pos, [](const State* s, const State* t) {
+					return s->earliest_finish_time() < t->earliest_finish_time();
+				});
+				std::rotate(to, pos, pos + 1);
+			}
+		};
+	}
+}
+
+#endif
@@ -2,9 +2,15 @@
 #define GLOBAL_SPACE_H
 
 #include <algorithm>
+#include <array>
+#include <chrono>
 #include <deque>
+#include <functional>
 #include <forward_list>
 #include <map>
+#include <memory>
+#include <sstream>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -16,9 +22,9 @@
 #include "reconfiguration/agent.hpp"
 
 #ifdef CONFIG_PARALLEL
-#include "tbb/concurrent_hash_map.h"
 #include "tbb/enumerable_thread_specific.h"
 #include "tbb/parallel_for.h"
+#include "tbb/task_arena.h"
 #include <atomic>
 #endif
 
@@ -26,6 +32,11 @@
 #include "global/state_space_data.hpp"
 #include "clock.hpp"
 
+#include "global/checkpoint.hpp"
+#include "global/decomposition.hpp"
+#include "global/node_table.hpp"
+#include "global/periodic.hpp"
+#include "global/spill.hpp"
 #include "global/state.hpp"
 
 namespace NP {
@@ -50,22 +61,56 @@ namespace NP {
 				const Analysis_options& opts,
 				Reconfiguration::Agent<Time> *reconfiguration_agent = nullptr)
 			{
-#ifdef CONFIG_PARALLEL
-				if (reconfiguration_agent) {
-					throw std::invalid_argument("Reconfiguration agents are not supported in multi-threaded analyses");
-				}
-#endif
 				if (opts.verbose)
 					std::cout << "Starting" << std::endl;
 
 				State_space* s = new State_space(prob.jobs, prob.prec, prob.aborts, prob.num_processors, 
 					{ opts.merge_conservative, opts.merge_use_job_finish_times, opts.merge_depth }, opts.timeout, opts.max_depth, opts.early_exit, opts.verbose, reconfiguration_agent);
 				s->be_naive = opts.be_naive;
+				s->sort_frontier = opts.sort_frontier && !opts.be_naive && !reconfiguration_agent;
+				if (opts.zobrist_keys)
+					s->state_space_data.use_zobrist_keys();
+				s->collect_graph = opts.collect_schedule_graph;
+				if (!opts.be_naive && !reconfiguration_agent && !opts.collect_schedule_graph) {
+					s->memory_limit = opts.memory_limit;
+					s->spill_dir = opts.spill_dir;
+					s->checkpoint_file = opts.checkpoint_file;
+					s->checkpoint_interval = opts.checkpoint_interval;
+					s->resume = opts.resume;
+					// the transitions recorded to sort the next depth refer to the nodes of the current one
+					if (s->memory_limit)
+						s->sort_frontier = false;
+				}
+				if (opts.hyperperiod > 0 && !reconfiguration_agent && !opts.collect_schedule_graph) {
+					s->periodic.reset(new Periodic_jobs<Time>(prob, (Time)opts.hyperperiod));
+					if (!s->periodic->is_periodic())
+						s->periodic.reset();
+				}
 				if (opts.verbose)
 					std::cout << "Analysing" << std::endl;
 				s->cpu_time.start();
-				s->explore();
+				if (opts.decompose && !reconfiguration_agent && !opts.collect_schedule_graph
+					&& !opts.max_depth && opts.checkpoint_file.empty()) {
+					Idle_point_decomposition<Time> segments(prob);
+					if (segments.number_of_segments() > 1) {
+						s->explore_segments(prob, opts, segments);
+						s->cpu_time.stop();
+						if (opts.verbose)
+							s->print_lookup_statistics();
+						return s;
+					}
+				}
+				try {
+					s->explore();
+				}
+				catch (...) {
+					// e.g., an unreadable checkpoint or spill file
+					delete s;
+					throw;
+				}
 				s->cpu_time.stop();
+				if (opts.verbose)
+					s->print_lookup_statistics();
 				return s;
 			}
 
@@ -132,6 +177,39 @@ namespace NP {
 				return num_edges;
 			}
 
+			// the number of times a new state was compared with a state of a node
+			// to find a state it can be merged with (see Schedule_node::merge_states())
+			unsigned long number_of_merge_attempts() const
+			{
+				return num_merge_attempts;
+			}
+
+			// the largest number of such comparisons with the states of a single node
+			unsigned long max_merge_attempts_per_node() const
+			{
+				return max_node_merge_attempts;
+			}
+
+			// the number of times a node of the next depth was found with the key and fingerprint
+			// of a new node, and the number of those nodes that had another set of scheduled
+			// jobs (see same_scheduled_jobs())
+			unsigned long number_of_key_matches() const
+			{
+				return num_key_matches;
+			}
+
+			unsigned long number_of_key_collisions() const
+			{
+				return num_key_collisions;
+			}
+
+			// the number of nodes that were moved to disk because of the memory limit
+			// (a node may be counted several times if it was spilled several times)
+			unsigned long number_of_spilled_nodes() const
+			{
+				return num_spilled_nodes;
+			}
+
 			unsigned long max_exploration_front_width() const
 			{
 				return max_width;
@@ -142,9 +220,38 @@ namespace NP {
 				return width;
 			}
 
+#ifdef CONFIG_PARALLEL
+			// fraction of the wall-clock time that the worker threads spent
+			// exploring nodes, for each depth of the exploration
+			const std::vector<double>& evolution_thread_utilization() const
+			{
+				return thread_utilization;
+			}
+#endif
+
 			double get_cpu_time() const
 			{
-				return cpu_time;
+				return cpu_time + cpu_time_before_resume;
+			}
+
+			// the depth at which the analysis was resumed from a checkpoint (0 if it was not)
+			unsigned long resumed_at_depth() const
+			{
+				return resumed_depth;
+			}
+
+			// the depth at which the exploration was found to repeat itself one
+			// hyperperiod later (0 if it was not, see check_periodic_front)
+			unsigned long periodic_at_depth() const
+			{
+				return periodic_depth;
+			}
+
+			// the number of segments that were analysed separately (1 if the
+			// problem was not decomposed, see explore_segments)
+			std::size_t number_of_segments() const
+			{
+				return num_segments;
 			}
 
 			typedef std::deque<Node> Nodes;
@@ -157,16 +264,17 @@ namespace NP {
 			typedef std::deque< Nodes > Nodes_storage;
 #endif
 
-#ifdef CONFIG_COLLECT_SCHEDULE_GRAPH
-
+			// An edge of the recorded schedule graph. The nodes are identified by
+			// their index in get_graph_nodes(), such that the nodes themselves
+			// can still be freed once their depth has been explored.
 			struct Edge {
 				const Job<Time>* scheduled;
-				const Node* source;
-				const Node* target;
-				const Interval<Time> finish_range;
-				const unsigned int parallelism;
+				unsigned long source;
+				unsigned long target;
+				Interval<Time> finish_range;
+				unsigned int parallelism;
 
-				Edge(const Job<Time>* s, const Node* src, const Node* tgt,
+				Edge(const Job<Time>* s, unsigned long src, unsigned long tgt,
 					const Interval<Time>& fr, unsigned int parallelism = 1)
 					: scheduled(s)
 					, source(src)
@@ -207,30 +315,30 @@ namespace NP {
 				}
 			};
 
-			const std::deque<Edge>& get_edges() const
+			// the edges of the schedule graph (if it was collected)
+			const std::vector<Edge>& get_edges() const
 			{
 				return edges;
 			}
 
-			const Nodes_storage& get_nodes() const
+			// the labels of the nodes of the schedule graph (if it was collected)
+			const std::vector<std::string>& get_graph_nodes() const
 			{
-				return nodes_storage;
+				return graph_nodes;
 			}
 
-
-#endif
 		private:
 
 			typedef Node* Node_ref;
+			typedef typename Node::State_iterator State_iterator;
 			typedef typename std::forward_list<Node_ref> Node_refs;
 			typedef State* State_ref;
 			typedef typename std::forward_list<State_ref> State_refs;
 
 #ifdef CONFIG_PARALLEL
-			typedef tbb::concurrent_hash_map<hash_value_t, Node_refs> Nodes_map;
-			typedef typename Nodes_map::accessor Nodes_map_accessor;
+			typedef Concurrent_node_table<Node> Nodes_map;
 #else
-			typedef std::unordered_map<hash_value_t, Node_refs> Nodes_map;
+			typedef Node_table<Node> Nodes_map;
 #endif
 			typedef const Job<Time>* Job_ref;
 
@@ -249,9 +357,27 @@ namespace NP {
 			};
 			typedef std::vector<Response_time_item> Response_times;
 
-#ifdef CONFIG_COLLECT_SCHEDULE_GRAPH
-			std::deque<Edge> edges;
+			// the schedule graph: an edge is first recorded with pointers to its nodes
+			// in a per-thread buffer, and turned into an Edge when the nodes of the
+			// next depth are complete (see collect_graph_depth)
+			bool collect_graph;
+			struct Pending_edge {
+				const Job<Time>* scheduled;
+				const Node* source;
+				const Node* target;
+				Interval<Time> finish_range;
+				unsigned int parallelism;
+			};
+			typedef std::vector<Pending_edge> Pending_edges;
+#ifdef CONFIG_PARALLEL
+			tbb::enumerable_thread_specific<Pending_edges> pending_edges;
+#else
+			Pending_edges pending_edges;
 #endif
+			std::vector<Edge> edges;
+			std::vector<std::string> graph_nodes;
+			// the index of every node of the last two depths in graph_nodes
+			std::unordered_map<const Node*, unsigned long> graph_node_index;
 			// Similar to uni/space.hpp, make rta a 
 
 			Response_times rta;
@@ -269,19 +395,111 @@ namespace NP {
 
 			bool be_naive;
 
+			// build the nodes of the next depth with build_frontier_by_sorting()
+			bool sort_frontier;
+
+			// Out-of-core exploration: the nodes of the next depth are moved to disk
+			// when (an estimate of) their memory use exceeds memory_limit, and the
+			// front is then explored one partition at a time (see explore_spilled_front)
+			typedef Spilled_front<Node> Spill;
+			std::size_t memory_limit;
+			std::string spill_dir;
+			std::unique_ptr<Spill> spilled_front, spilled_next;
+			// values of num_nodes and num_states when the nodes of the next depth
+			// that are in memory started to be built
+			unsigned long next_nodes_base, next_states_base;
+			unsigned long num_spilled_nodes;
+
+			// checkpoints (see write_checkpoint)
+			std::string checkpoint_file;
+			double checkpoint_interval;
+			bool resume;
+			double next_checkpoint_time;
+			unsigned long last_checkpoint_depth;
+			unsigned long resumed_depth;
+			double cpu_time_before_resume;
+			// the exploration was stopped by the time or depth limit, so its checkpoint is kept
+			bool interrupted;
+
+			std::size_t num_segments;
+
+			// Periodic job sets (see check_periodic_front): the fronts of the last
+			// hyperperiod's worth of depths, shifted by one hyperperiod, and the
+			// finish times found while exploring these depths
+			std::unique_ptr<Periodic_jobs<Time>> periodic;
+			struct Front_snapshot {
+				struct Entry {
+					Job_set jobs;
+					std::size_t num_states;
+					// offset of the states in 'states'
+					std::size_t first_state;
+				};
+				unsigned long depth;
+				std::unordered_map<hash_value_t, std::deque<Entry>> by_key;
+				Spill_writer states;
+			};
+			std::deque<Front_snapshot> recent_fronts;
+			struct Depth_finish_times {
+				Response_times rt;
+				std::vector<Job_index> found;
+			};
+#ifdef CONFIG_PARALLEL
+			tbb::enumerable_thread_specific<Depth_finish_times> depth_finish_times;
+#else
+			Depth_finish_times depth_finish_times;
+#endif
+			std::deque<std::vector<std::pair<Job_index, Interval<Time>>>> recent_finish_times;
+			unsigned long periodic_depth;
+
 			struct Merge_options {
 				bool conservative; 
 				bool use_finish_times; 
 				int budget;
 			};
 			const Merge_options merge_opts;
+			// one state pool per depth in nodes_storage; declared first such that
+			// the nodes (and their states) are destroyed before the pools
+			std::deque<State_pool<Time>> state_pools;
 			Nodes_storage nodes_storage;
 			Nodes_map nodes_by_key;
 
+			// A dispatch of a job in a state, recorded while exploring a depth
+			// when the next depth is built by sorting (see build_frontier_by_sorting)
+			struct Transition {
+				hash_value_t key;
+				hash_value_t fingerprint;
+				const Node* from;
+				const State* state;
+				Job_index job;
+				Interval<Time> start_times;
+				Interval<Time> finish_times;
+				unsigned int ncores;
+			};
+			typedef std::vector<Transition> Transitions;
+#ifdef CONFIG_PARALLEL
+			tbb::enumerable_thread_specific<Transitions> transitions;
+#else
+			Transitions transitions;
+#endif
+
 #ifdef CONFIG_PARALLEL
 			std::atomic_ulong num_nodes, num_states, num_edges;
 #else
 			unsigned long num_nodes, num_states, num_edges;
+#endif
+			// the new states that were compared with the states of a node, the comparisons,
+			// and the most comparisons in one node (see count_merge_attempts())
+#ifdef CONFIG_PARALLEL
+			std::atomic_ulong num_merge_calls, num_merge_attempts, max_node_merge_attempts;
+#else
+			unsigned long num_merge_calls, num_merge_attempts, max_node_merge_attempts;
+#endif
+			// the nodes found with the key and fingerprint of a new node, and those among
+			// them with a different set of scheduled jobs (see same_scheduled_jobs())
+#ifdef CONFIG_PARALLEL
+			std::atomic_ulong num_key_matches, num_key_collisions;
+#else
+			unsigned long num_key_matches, num_key_collisions;
 #endif
 			// updated only by main thread
 			unsigned long current_job_count, max_width;
@@ -289,6 +507,7 @@ namespace NP {
 
 #ifdef CONFIG_PARALLEL
 			tbb::enumerable_thread_specific<unsigned long> edge_counter;
+			std::vector<double> thread_utilization;
 #endif
 			Processor_clock cpu_time;
 			const double timeout;
@@ -312,6 +531,21 @@ namespace NP {
 				, timed_out(false)
 				, observed_deadline_miss(false)
 				, be_naive(false)		
+				, sort_frontier(false)
+				, collect_graph(false)
+				, memory_limit(0)
+				, next_nodes_base(0)
+				, next_states_base(0)
+				, num_spilled_nodes(0)
+				, checkpoint_interval(0)
+				, resume(false)
+				, next_checkpoint_time(0)
+				, last_checkpoint_depth(0)
+				, resumed_depth(0)
+				, cpu_time_before_resume(0)
+				, interrupted(false)
+				, num_segments(1)
+				, periodic_depth(0)
 				, timeout(max_cpu_time)
 				, max_depth(max_depth)
 				, merge_opts(merge_options)
@@ -319,6 +553,11 @@ namespace NP {
 				, num_nodes(0)
 				, num_states(0)
 				, num_edges(0)
+				, num_merge_calls(0)
+				, num_merge_attempts(0)
+				, max_node_merge_attempts(0)
+				, num_key_matches(0)
+				, num_key_collisions(0)
 				, max_width(0)
 				, width(jobs.size(), { 0,0 })
 				, rta(jobs.size())
@@ -328,6 +567,7 @@ namespace NP {
 				, reconfiguration_agent(reconfiguration_agent)
 #ifdef CONFIG_PARALLEL
 				, partial_rta(jobs.size())
+				, thread_utilization(jobs.size(), 0.0)
 #endif
 			{
 			}
@@ -378,11 +618,25 @@ namespace NP {
 					rta;
 #endif
 				update_finish_times(r, n, j, range);
+				if (periodic) {
+					Depth_finish_times& d =
+#ifdef CONFIG_PARALLEL
+						depth_finish_times.local();
+#else
+						depth_finish_times;
+#endif
+					if (d.rt.empty())
+						d.rt.resize(state_space_data.num_jobs());
+					if (!d.rt[j.get_job_index()].valid)
+						d.found.push_back(j.get_job_index());
+					update_finish_times(d.rt, j.get_job_index(), range);
+				}
 			}
 
 			void make_initial_node(unsigned num_cores)
 			{
 				// construct initial state
+				state_pools.emplace_back();
 				nodes_storage.emplace_back();
 
 				Reconfiguration::Attachment *attachment = nullptr;
@@ -406,7 +660,8 @@ namespace NP {
 			template <typename... Args>
 			Node_ref alloc_node(Args&&... args)
 			{
-				nodes().emplace_back(std::forward<Args>(args)...);
+				// the states of the new node are allocated from the pool of its depth
+				nodes().emplace_back(std::forward<Args>(args)..., &state_pools.back());
 				Node_ref n = &(*(--nodes().end()));
 
 				// make sure we didn't screw up...
@@ -420,89 +675,177 @@ namespace NP {
 				return n;
 			}
 
+			// The set of scheduled jobs of a node reached by dispatching j in n. All nodes that
+			// are reached by dispatching j in n share one set (next_jobs, which is set by the
+			// first call), as do the nodes with the same set that may not be merged.
+			const Job_set& next_job_set(const Node& n, const Job<Time>& j, const Job_set*& next_jobs)
+			{
+				if (!next_jobs)
+					next_jobs = &state_pools.back().derive_job_set(n.get_scheduled_jobs(), j.get_job_index());
+				return *next_jobs;
+			}
+
 			template <typename... Args>
 			State& new_state(Args&&... args)
 			{
-				return *(new State(std::forward<Args>(args)...));
+				return *(state_pools.back().create(std::forward<Args>(args)...));
 			}
 
 
+			// n must not be modified concurrently
+			void count_merge_attempts(const Node& n, unsigned long attempts)
+			{
+				num_merge_calls++;
+				num_merge_attempts += attempts;
+				unsigned long in_node = n.number_of_merge_attempts();
+#ifdef CONFIG_PARALLEL
+				unsigned long max = max_node_merge_attempts;
+				while (in_node > max && !max_node_merge_attempts.compare_exchange_weak(max, in_node));
+#else
+				max_node_merge_attempts = std::max(max_node_merge_attempts, in_node);
+#endif
+			}
+
+			void print_lookup_statistics() const
+			{
+				std::cout << "Merge attempts: " << num_merge_attempts;
+				if (num_merge_calls)
+					std::cout << " (" << (double)num_merge_attempts / num_merge_calls << " per new state, at most "
+						<< max_node_merge_attempts << " in one node)";
+				std::cout << std::endl;
+				std::cout << "Node lookups with a matching key: " << num_key_matches << " (" << num_key_collisions
+					<< " with a different set of scheduled jobs";
+				if (state_space_data.has_zobrist_keys())
+#ifdef NDEBUG
+					std::cout << ", Zobrist keys are trusted";
+#else
+					std::cout << ", Zobrist keys";
+#endif
+				std::cout << ")" << std::endl;
+			}
+
+			// Whether node other, which has the key and fingerprint of the node reached by
+			// dispatching job j in a node with the set of scheduled jobs 'from', has the set
+			// of scheduled jobs of that node. With Zobrist keys (see State_space_data::
+			// use_zobrist_keys()), the key is trusted, and the sets are only compared in
+			// debug builds.
+			bool same_scheduled_jobs(const Node& other, const Job_set& from, Job_index j)
+			{
+				num_key_matches++;
+#ifdef NDEBUG
+				if (state_space_data.has_zobrist_keys())
+					return true;
+#endif
+				if (other.get_scheduled_jobs().is_derived_from(from, j))
+					return true;
+				num_key_collisions++;
+				return false;
+			}
+
 			template <typename... Args>
 			void new_or_merge_state(Node& n, Args&&... args)
 			{
 				// create a new state.
 				State& new_s = new_state(std::forward<Args>(args)...);
 
-				// try to merge the new state with existing states in node n.
+#ifdef CONFIG_PARALLEL
+				// other threads may add states to n at the same time
+				typename Node::Mutex::scoped_lock lock(n.get_mutex());
+#endif
+				num_states += merge_or_add_state(n, new_s);
+			}
+
+			// try to merge new_s with the existing states in node n, or add it to n otherwise;
+			// returns by how much the number of states changed (n must not be modified concurrently)
+			long merge_or_add_state(Node& n, State& new_s)
+			{
+				return merge_or_add_state(n, new_s, state_pools.back());
+			}
+
+			// same, for a state allocated from pool
+			long merge_or_add_state(Node& n, State& new_s, State_pool<Time>& pool)
+			{
 				if (!(n.get_states()->empty())) {
+					unsigned long attempts = n.number_of_merge_attempts();
 					int n_states_merged = n.merge_states(new_s, merge_opts.conservative, merge_opts.use_finish_times, merge_opts.budget);
+					count_merge_attempts(n, n.number_of_merge_attempts() - attempts);
 					if (n_states_merged > 0) {
-						delete& new_s; // if we could merge no need to keep track of the new state anymore
-						num_states -= (n_states_merged - 1);
-					}
-					else
-					{
-						n.add_state(&new_s); // else add the new state to the node
-						num_states++;
+						pool.release(&new_s); // if we could merge no need to keep track of the new state anymore
+						return 1 - n_states_merged;
 					}
 				}
-				else
-				{
-					n.add_state(&new_s); // else add the new state to the node
-					num_states++;
-				}
+				n.add_state(&new_s); // else add the new state to the node
+				return 1;
 			}
 
 
 #ifdef CONFIG_PARALLEL
-			// make node available for fast lookup
-			void insert_cache_node(Nodes_map_accessor& acc, Node_ref n)
-			{
-				assert(!acc.empty());
-
-				Node_refs& list = acc->second;
-				list.push_front(n);
-			}
-
 			template <typename... Args>
-			Node& new_node_at(Nodes_map_accessor& acc, Args&&... args)
+			Node& new_node(Args&&... args)
 			{
-				assert(!acc.empty());
 				Node_ref n = alloc_node(std::forward<Args>(args)...);
 				DM("new node - global " << n << std::endl);
 				// add node to nodes_by_key map.
-				insert_cache_node(acc, n);
+				nodes_by_key.insert(n->get_key(), n->get_fingerprint(), n);
 				num_nodes++;
 				return *n;
 			}
 
-			template <typename... Args>
-			Node& new_node(Args&&... args)
+			// find the node reached by dispatching j in n, or create it if no other thread did so yet
+			// (next_jobs as for next_job_set())
+			Node& find_or_new_node(const Node& n, const Job<Time>& j, const Job_set*& next_jobs)
 			{
-				Nodes_map_accessor acc;
-				Node_ref n = alloc_node(std::forward<Args>(args)...);
-				while (true) {
-					if (nodes_by_key.find(acc, n->get_key()) || nodes_by_key.insert(acc, n->get_key())) {
-						DM("new node - global " << n << std::endl);
-						// add node to nodes_by_key map.
-						insert_cache_node(acc, n);
+				Node_ref created = nullptr;
+				Node_ref next = nodes_by_key.find_or_insert(state_space_data.next_key(n, j), state_space_data.next_fingerprint(n, j),
+					[&](Node_ref other) {
+						if (!same_scheduled_jobs(*other, n.get_scheduled_jobs(), j.get_job_index()))
+							return false;
+						// a node that may not be merged with still shares its set of scheduled jobs
+						next_jobs = &other->get_scheduled_jobs();
+						if (!reconfiguration_agent)
+							return true;
+						// wait until the thread that created other has given it its attachment
+						typename Node::Mutex::scoped_lock lock(other->get_mutex());
+						return reconfiguration_agent->allow_merge(n, j, *other);
+					},
+					[&]() {
 						num_nodes++;
-						return *n;
+						created = alloc_node(n, j, j.get_job_index(), next_job_set(n, j, next_jobs), state_space_data,
+							state_space_data.earliest_possible_job_release(n, j),
+							state_space_data.earliest_certain_source_job_release(n, j),
+							state_space_data.earliest_certain_sequential_source_job_release(n, j),
+							nullptr);
+						// the attachment is only created once the node is certainly used (it numbers
+						// the node in the agent), so keep other threads from merging into it until then
+						if (reconfiguration_agent)
+							created->get_mutex().lock();
+						return created;
+					},
+					[&](Node_ref lost) {
+						// another thread created the same node concurrently; ours is the last one this thread allocated
+						assert(lost == &nodes().back());
+						if (reconfiguration_agent)
+							lost->get_mutex().unlock();
+						nodes().pop_back();
+						num_nodes--;
+						created = nullptr;
+					});
+				if (reconfiguration_agent) {
+					if (next == created) {
+						next->attachment = reconfiguration_agent->create_next_node_attachment(n, j);
+						next->get_mutex().unlock();
 					}
+					else
+						reconfiguration_agent->merge_node_attachments(next, n, j);
 				}
+				DM("=== dispatch: next is " << next << std::endl);
+				return *next;
 			}
 
 #else
 			void cache_node(Node_ref n)
 			{
-				// create a new list if needed, or lookup if already existing
-				auto res = nodes_by_key.emplace(
-					std::make_pair(n->get_key(), Node_refs()));
-
-				auto pair_it = res.first;
-				Node_refs& list = pair_it->second;
-
-				list.push_front(n);
+				nodes_by_key.insert(n->get_key(), n->get_fingerprint(), n);
 			}
 
 			template <typename... Args>
@@ -522,13 +865,16 @@ namespace NP {
 				if (timeout && get_cpu_time() > timeout) {
 					aborted = true;
 					timed_out = true;
+					interrupted = true;
 				}
 			}
 
 			void check_depth_abort()
 			{
-				if (max_depth && current_job_count > max_depth)
+				if (max_depth && current_job_count > max_depth) {
 					aborted = true;
+					interrupted = true;
+				}
 			}
 
 			bool unfinished(const Node& n, const Job<Time>& j) const
@@ -539,6 +885,10 @@ namespace NP {
 			// Check if any job is guaranteed to miss its deadline in any state in node new_n
 			void check_for_deadline_misses(const Node& old_n, const Node& new_n)
 			{
+#ifdef CONFIG_PARALLEL
+				// other threads may still add states to new_n
+				typename Node::Mutex::scoped_lock lock(new_n.get_mutex());
+#endif
 				auto check_from = old_n.get_first_state()->core_availability().min();
 
 				// check if we skipped any jobs that are now guaranteed
@@ -562,7 +912,8 @@ namespace NP {
 								// create a dummy node for explanation purposes
 								auto frange = new_n.get_last_state()->core_availability(pmin) + j.get_cost(pmin);
 								Node& next =
-									new_node(new_n, j, j.get_job_index(), state_space_data, 0, 0, 0, nullptr);
+									new_node(new_n, j, j.get_job_index(), state_pools.back().derive_job_set(new_n.get_scheduled_jobs(), j.get_job_index()),
+										state_space_data, 0, 0, 0, nullptr);
 								//const CoreAvailability empty_cav = {};
 								State& next_s = new_state(*new_n.get_last_state(), j.get_job_index(), frange, frange, new_n.get_scheduled_jobs(), new_n.get_jobs_with_pending_successors(), new_n.get_ready_successor_jobs(), state_space_data, new_n.get_next_certain_source_job_release(), pmin);
 								next.add_state(&next_s);
@@ -570,9 +921,8 @@ namespace NP {
 
 								// update response times
 								update_finish_times(new_n, j, frange);
-#ifdef CONFIG_COLLECT_SCHEDULE_GRAPH
-								edges.emplace_back(&j, &new_n, &next, frange, pmin);
-#endif
+								if (collect_graph)
+									record_edge(&j, &new_n, &next, frange, pmin);
 								count_edge();
 							}
 							break;
@@ -656,23 +1006,24 @@ namespace NP {
 				}
 			}
 
-			bool dispatch(const Node& n, const Job<Time>& j, Time t_wc_wos, Time t_high_wos)
+			// dispatch j in the states [first_state, last_state) of node n
+			bool dispatch(const Node& n, const Job<Time>& j, Time t_wc_wos, Time t_high_wos,
+				State_iterator first_state, State_iterator last_state)
 			{
 				// All states in node 'n' for which the job 'j' is eligible will 
 				// be added to that same node. 
 				// If such a node already exists, we keep a reference to it
 				Node_ref next = nullptr;
+				// the set of scheduled jobs of the nodes reached by dispatching j in n (see next_job_set())
+				const Job_set* next_jobs = nullptr;
 				DM("--- global:dispatch() " << n << ", " << j << ", " << t_wc_wos << ", " << t_high_wos << std::endl);
 
 				bool dispatched_one = false;
 
-				// loop over all states in the node n
-				const auto* n_states = n.get_states();
-#ifdef CONFIG_PARALLEL
-				Nodes_map_accessor acc;
-#endif
-				for (State* s : *n_states)
+				// loop over the states in the range
+				for (auto st = first_state; st != last_state; st++)
 				{
+					State* s = *st;
 					const auto& costs = j.get_all_costs();
 					// check for all possible parallelism levels of the moldable gang job j (if j is not gang or not moldable than min_paralellism = max_parallelism and costs only constains a single element).
 					//for (unsigned int p = j.get_max_parallelism(); p >= j.get_min_parallelism(); p--)
@@ -712,49 +1063,39 @@ namespace NP {
 						// update finish-time estimates
 						update_finish_times(n, j, ftimes);
 
+						if (sort_frontier) {
+							// the node and state are built once the whole depth has been explored
 #ifdef CONFIG_PARALLEL
-						// if we do not have a pointer to a node with the same set of scheduled job yet,
-						// try to find an existing node with the same set of scheduled jobs. Otherwise, create one.
-						if (next == nullptr || acc.empty())
-						{
-							auto next_key = n.next_key(j);
-							Job_set new_sched_jobs{ n.get_scheduled_jobs(), j.get_job_index() };
-
-							while (next == nullptr || acc.empty()) {
-								// check if key exists
-								if (nodes_by_key.find(acc, next_key)) {
-									// If be_naive, a new node and a new state should be created for each new job dispatch.
-									if (be_naive) {
-										next = &(new_node_at(acc, n, j, j.get_job_index(), state_space_data, state_space_data.earliest_possible_job_release(n, j), state_space_data.earliest_certain_source_job_release(n, j), state_space_data.earliest_certain_sequential_source_job_release(n, j), nullptr));
-									}
-									else
-									{
-										for (Node_ref other : acc->second) {
-											if (other->get_scheduled_jobs() == new_sched_jobs) {
-												next = other;
-												DM("=== dispatch: next exists." << std::endl);
-												break;
-											}
-										}
-										if (next == nullptr) {
-											next = &(new_node_at(acc, n, j, j.get_job_index(), state_space_data, state_space_data.earliest_possible_job_release(n, j), state_space_data.earliest_certain_source_job_release(n, j), state_space_data.earliest_certain_sequential_source_job_release(n, j), nullptr));
-										}
-									}
-								}
-								if (next == nullptr) {
-									if (nodes_by_key.insert(acc, next_key)) {
-										next = &(new_node_at(acc, n, j, j.get_job_index(), state_space_data, state_space_data.earliest_possible_job_release(n, j), state_space_data.earliest_certain_source_job_release(n, j), state_space_data.earliest_certain_sequential_source_job_release(n, j), nullptr));
-									}
-								}
-								// if we raced with concurrent creation, try again
-							}
+							Transitions& local_transitions = transitions.local();
+#else
+							Transitions& local_transitions = transitions;
+#endif
+							local_transitions.push_back(Transition{ state_space_data.next_key(n, j), state_space_data.next_fingerprint(n, j), &n, s,
+								j.get_job_index(), Interval<Time>{_st}, ftimes, p });
+							count_edge();
+							continue;
 						}
+
+#ifdef CONFIG_PARALLEL
 						// If be_naive, a new node and a new state should be created for each new job dispatch.
-						else if (be_naive) {
-							// note that the accessor should be pointing on something at this point
-							next = &(new_node_at(acc, n, j, j.get_job_index(), state_space_data, state_space_data.earliest_possible_job_release(n, j), state_space_data.earliest_certain_source_job_release(n, j), state_space_data.earliest_certain_sequential_source_job_release(n, j), nullptr));
+						if (be_naive) {
+							Reconfiguration::Attachment *attachment = nullptr;
+							if (reconfiguration_agent) attachment = reconfiguration_agent->create_next_node_attachment(
+									n, j
+							);
+							next = &(new_node(
+									n, j, j.get_job_index(), next_job_set(n, j, next_jobs), state_space_data,
+									state_space_data.earliest_possible_job_release(n, j),
+									state_space_data.earliest_certain_source_job_release(n, j),
+									state_space_data.earliest_certain_sequential_source_job_release(n, j),
+									attachment
+							));
+						}
+						// if we do not have a pointer to a node with the same set of scheduled job yet,
+						// try to find an existing node with the same set of scheduled jobs. Otherwise, create one.
+						else if (next == nullptr) {
+							next = &find_or_new_node(n, j, next_jobs);
 						}
-						assert(!acc.empty());
 #else
 						// If be_naive, a new node and a new state should be created for each new job dispatch.
 						if (be_naive) {
@@ -763,7 +1104,7 @@ namespace NP {
 									n, j
 							);
 							next = &(new_node(
-									n, j, j.get_job_index(), state_space_data,
+									n, j, j.get_job_index(), next_job_set(n, j, next_jobs), state_space_data,
 									state_space_data.earliest_possible_job_release(n, j),
 									state_space_data.earliest_certain_source_job_release(n, j),
 									state_space_data.earliest_certain_sequential_source_job_release(n, j),
@@ -775,21 +1116,16 @@ namespace NP {
 						// try to find an existing node with the same set of scheduled jobs. Otherwise, create one.
 						if (next == nullptr)
 						{
-							const auto pair_it = nodes_by_key.find(n.next_key(j));
-							if (pair_it != nodes_by_key.end()) {
-								Job_set new_sched_jobs{ n.get_scheduled_jobs(), j.get_job_index() };
-								for (Node_ref other : pair_it->second) {
-									if (other->get_scheduled_jobs() == new_sched_jobs)
-									{
-										if (reconfiguration_agent && !reconfiguration_agent->allow_merge(
-												n, j, *other)
-										) continue;
-										next = other;
-										if (reconfiguration_agent) reconfiguration_agent->merge_node_attachments(other, n, j);
-										DM("=== dispatch: next exists." << std::endl);
-										break;
-									}
-								}
+							next = nodes_by_key.find(state_space_data.next_key(n, j), state_space_data.next_fingerprint(n, j), [&](Node_ref other) {
+								if (!same_scheduled_jobs(*other, n.get_scheduled_jobs(), j.get_job_index()))
+									return false;
+								// a node that may not be merged with still shares its set of scheduled jobs
+								next_jobs = &other->get_scheduled_jobs();
+								return !reconfiguration_agent || reconfiguration_agent->allow_merge(n, j, *other);
+							});
+							if (next != nullptr) {
+								if (reconfiguration_agent) reconfiguration_agent->merge_node_attachments(next, n, j);
+								DM("=== dispatch: next exists." << std::endl);
 							}
 							// If there is no node yet, create one.
 							if (next == nullptr) {
@@ -798,7 +1134,7 @@ namespace NP {
 										n, j
 								);
 								next = &(new_node(
-										n, j, j.get_job_index(), state_space_data,
+										n, j, j.get_job_index(), next_job_set(n, j, next_jobs), state_space_data,
 										state_space_data.earliest_possible_job_release(n, j),
 										state_space_data.earliest_certain_source_job_release(n, j),
 										state_space_data.earliest_certain_sequential_source_job_release(n,j),
@@ -818,9 +1154,8 @@ namespace NP {
 							check_for_deadline_misses(n, *next);
 						}
 
-#ifdef CONFIG_COLLECT_SCHEDULE_GRAPH
-						edges.emplace_back(&j, &n, next, ftimes);
-#endif
+						if (collect_graph)
+							record_edge(&j, &n, next, ftimes, p);
 						count_edge();
 					}
 				}
@@ -837,6 +1172,14 @@ namespace NP {
 			void explore(const Node& n)
 			{
 				if (reconfiguration_agent && !reconfiguration_agent->should_explore(n)) return;
+				bool found_one = dispatch_jobs(n, n.get_states()->begin(), n.get_states()->end());
+				check_dead_end(n, found_one);
+			}
+
+			// dispatch every job that may be eligible next in the states [first_state, last_state) of node n,
+			// and return whether at least one job could be dispatched
+			bool dispatch_jobs(const Node& n, State_iterator first_state, State_iterator last_state)
+			{
 				bool found_one = false;
 
 				DM("---- global:explore(node)" << n.finish_range() << std::endl);
@@ -877,7 +1220,7 @@ namespace NP {
 					// then j will never be the next job dispached by the scheduler
 					if (t_high_wos <= j.earliest_arrival())
 						continue;
-					found_one |= dispatch(n, j, upbnd_t_wc, t_high_wos);
+					found_one |= dispatch(n, j, upbnd_t_wc, t_high_wos, first_state, last_state);
 				}
 				// part 2: check ready successor jobs (i.e., jobs with precedence constraints that are completed) that are potentially eligible
 				for (auto it = n.get_ready_successor_jobs().begin();
@@ -899,10 +1242,223 @@ namespace NP {
 					// then j will never be the next job dispached by the scheduler
 					if (t_high_wos <= j.earliest_arrival())
 						continue;
-					found_one |= dispatch(n, j, upbnd_t_wc, t_high_wos);
+					found_one |= dispatch(n, j, upbnd_t_wc, t_high_wos, first_state, last_state);
+				}
+				return found_one;
+			}
+
+#ifdef CONFIG_PARALLEL
+			// A task of the exploration of a front: either a whole node, or a
+			// range of the states of a node with many states.
+			struct Work_unit {
+				const Node* node;
+				State_iterator first_state, last_state;
+				bool split;
+			};
+
+			// Explores all nodes of the front with TBB's work-stealing scheduler.
+			// The work is divided into units of about the same number of states,
+			// independently of which thread created which node, and nodes with many
+			// states are split into several units that are explored concurrently.
+			void explore_front(const Split_nodes& front)
+			{
+				typedef std::chrono::steady_clock Clock;
+				auto start = Clock::now();
+
+				unsigned long total_states = 0;
+				for (const Nodes& nodes : front)
+					for (const Node& n : nodes)
+						total_states += n.get_states()->size();
+
+				// aim for several units per thread, but don't make them too small to be worth a task
+				const unsigned int num_threads = tbb::this_task_arena::max_concurrency();
+				const unsigned long max_states = std::max(8UL, total_states / (8 * num_threads));
+
+				std::vector<Work_unit> units;
+				// nodes that were split, and the index of their first unit
+				std::vector<std::pair<const Node*, std::size_t>> split_nodes;
+				for (const Nodes& nodes : front) {
+					for (const Node& n : nodes) {
+						const auto* states = n.get_states();
+						if (states->size() <= max_states) {
+							units.push_back({ &n, states->begin(), states->end(), false });
+							continue;
+						}
+						split_nodes.emplace_back(&n, units.size());
+						for (std::size_t i = 0; i < states->size(); i += max_states)
+							units.push_back({ &n, states->begin() + i, states->begin() + std::min<std::size_t>(i + max_states, states->size()), true });
+					}
 				}
+				// whether a job could be dispatched in the states of each unit of a split node
+				std::vector<char> dispatched(units.size(), 0);
+
+				tbb::enumerable_thread_specific<double> busy_time(0.0);
+				tbb::parallel_for(tbb::blocked_range<std::size_t>(0, units.size(), 1),
+					[&](const tbb::blocked_range<std::size_t>& r) {
+						auto busy_start = Clock::now();
+						for (std::size_t i = r.begin(); i != r.end(); i++) {
+							const Work_unit& u = units[i];
+							if (!u.split)
+								explore(*u.node);
+							else if (!reconfiguration_agent || reconfiguration_agent->should_explore(*u.node))
+								dispatched[i] = dispatch_jobs(*u.node, u.first_state, u.last_state);
+						}
+						busy_time.local() += std::chrono::duration<double>(Clock::now() - busy_start).count();
+					});
+
+				// a split node is a dead end only if no job could be dispatched in any of its states
+				for (std::size_t k = 0; k < split_nodes.size(); k++) {
+					const Node* n = split_nodes[k].first;
+					bool found_one = false;
+					for (std::size_t i = split_nodes[k].second; i < units.size() && units[i].node == n; i++)
+						found_one |= dispatched[i] != 0;
+					if (!reconfiguration_agent || reconfiguration_agent->should_explore(*n))
+						check_dead_end(*n, found_one);
+				}
+
+				double wall = std::chrono::duration<double>(Clock::now() - start).count();
+				double busy = busy_time.combine(std::plus<double>());
+				if (wall > 0 && current_job_count < thread_utilization.size())
+					thread_utilization[current_job_count] = busy / (wall * num_threads);
+			}
+#endif
+
+			// run f(0), ..., f(n - 1), in parallel if possible
+			template<class F>
+			static void for_each_index(std::size_t n, F f)
+			{
+#ifdef CONFIG_PARALLEL
+				tbb::parallel_for(std::size_t(0), n, f);
+#else
+				for (std::size_t i = 0; i < n; i++)
+					f(i);
+#endif
+			}
 
-				// check for a dead end
+			static const unsigned int frontier_radix_bits = 8;
+
+			// the partition of the transitions with the given key in build_frontier_by_sorting()
+			static std::size_t frontier_partition(hash_value_t key)
+			{
+				std::uint64_t h = (std::uint64_t) key;
+				h ^= h >> 32;
+				return (std::size_t) ((h * 0x9E3779B97F4A7C15ULL) >> (64 - frontier_radix_bits));
+			}
+
+			// Builds the nodes (and states) of the next depth from the transitions recorded
+			// while exploring the current one. The transitions are first partitioned by the
+			// top bits of their key in one radix pass, and each partition is then sorted by
+			// key and fingerprint, such that all transitions that can reach the same
+			// set of scheduled jobs are adjacent. Both steps are stable, so the states of a
+			// node are merged in the order in which the dispatches were recorded. The nodes
+			// themselves are created in the order of their keys though, such that the next
+			// depth may be explored (and its states merged) in another order than with the
+			// hash table. A partition is handled by a single task, so its nodes are built
+			// without any locks or shared lookup table.
+			void build_frontier_by_sorting()
+			{
+				static const std::size_t num_partitions = std::size_t(1) << frontier_radix_bits;
+				typedef std::array<std::size_t, num_partitions> Partition_counts;
+
+				std::vector<Transitions*> buffers;
+#ifdef CONFIG_PARALLEL
+				for (Transitions& local_transitions : transitions)
+					buffers.push_back(&local_transitions);
+#else
+				buffers.push_back(&transitions);
+#endif
+
+				// count the transitions of each buffer in each partition...
+				std::vector<Partition_counts> offsets(buffers.size());
+				for_each_index(buffers.size(), [&](std::size_t b) {
+					offsets[b].fill(0);
+					for (const Transition& t : *buffers[b])
+						offsets[b][frontier_partition(t.key)]++;
+				});
+				// ...turn the counts into the offset of each buffer in each partition...
+				std::vector<std::size_t> partition_start(num_partitions + 1);
+				std::size_t total = 0;
+				for (std::size_t p = 0; p < num_partitions; p++) {
+					partition_start[p] = total;
+					for (Partition_counts& o : offsets) {
+						std::size_t count = o[p];
+						o[p] = total;
+						total += count;
+					}
+				}
+				partition_start[num_partitions] = total;
+
+				// ...and scatter them, keeping the order in which each thread recorded them
+				// (the sort keys are copied next to the pointers such that sorting does not chase them)
+				struct Sort_entry {
+					hash_value_t key;
+					hash_value_t fingerprint;
+					const Transition* transition;
+				};
+				std::vector<Sort_entry> sorted(total);
+				for_each_index(buffers.size(), [&](std::size_t b) {
+					for (const Transition& t : *buffers[b])
+						sorted[offsets[b][frontier_partition(t.key)]++] = Sort_entry{ t.key, t.fingerprint, &t };
+				});
+
+				for_each_index(num_partitions, [&](std::size_t p) {
+					auto first = sorted.begin() + partition_start[p];
+					auto last = sorted.begin() + partition_start[p + 1];
+					std::stable_sort(first, last, [](const Sort_entry& a, const Sort_entry& b) {
+						if (a.key != b.key)
+							return a.key < b.key;
+						return a.fingerprint < b.fingerprint;
+					});
+
+					long added_states = 0;
+					unsigned long added_nodes = 0;
+					// the nodes created for the transitions with the current key and fingerprint
+					std::vector<Node_ref> candidates;
+					for (auto it = first; it != last;) {
+						const Transition& t = *it->transition;
+						if (it == first || std::prev(it)->key != t.key || std::prev(it)->fingerprint != t.fingerprint)
+							candidates.clear();
+
+						// different sets of scheduled jobs can still share the key and fingerprint
+						Node_ref next = nullptr;
+						for (Node_ref other : candidates)
+							if (same_scheduled_jobs(*other, t.from->get_scheduled_jobs(), t.job))
+								next = other;
+						if (next == nullptr) {
+							const Job<Time>& j = state_space_data.jobs[t.job];
+							next = alloc_node(*t.from, j, t.job, state_pools.back().derive_job_set(t.from->get_scheduled_jobs(), t.job), state_space_data,
+								state_space_data.earliest_possible_job_release(*t.from, j),
+								state_space_data.earliest_certain_source_job_release(*t.from, j),
+								state_space_data.earliest_certain_sequential_source_job_release(*t.from, j),
+								nullptr);
+							added_nodes++;
+							candidates.push_back(next);
+						}
+
+						// all states of the origin in which the job was dispatched
+						for (; it != last && it->transition->from == t.from && it->transition->job == t.job; it++) {
+							const Transition& u = *it->transition;
+							State& new_s = new_state(*u.state, u.job, u.start_times, u.finish_times,
+								next->get_scheduled_jobs(), next->get_jobs_with_pending_successors(), next->get_ready_successor_jobs(),
+								state_space_data, next->get_next_certain_source_job_release(), u.ncores);
+							added_states += merge_or_add_state(*next, new_s);
+							if (collect_graph)
+								record_edge(&state_space_data.jobs[u.job], u.from, next, u.finish_times, u.ncores);
+						}
+
+						if (early_exit)
+							check_for_deadline_misses(*t.from, *next);
+					}
+					num_nodes += added_nodes;
+					num_states += added_states;
+				});
+
+				for (Transitions* b : buffers)
+					b->clear();
+			}
+
+			void check_dead_end(const Node& n, bool found_one)
+			{
 				if (!found_one && !all_jobs_scheduled(n)) {
 					// out of options and we didn't schedule all jobs
 					observed_deadline_miss = true;
@@ -918,6 +1474,630 @@ namespace NP {
 				explore();
 			}
 
+			void record_edge(const Job<Time>* scheduled, const Node* source, const Node* target,
+				Interval<Time> finish_range, unsigned int parallelism)
+			{
+#ifdef CONFIG_PARALLEL
+				Pending_edges& local_edges = pending_edges.local();
+#else
+				Pending_edges& local_edges = pending_edges;
+#endif
+				local_edges.push_back(Pending_edge{ scheduled, source, target, finish_range, parallelism });
+			}
+
+			std::string graph_node_label(const Node& n) const
+			{
+				std::ostringstream out;
+				out << "{";
+				for (State* s : *n.get_states()) {
+					out << "[";
+					s->print_vertex_label(out, state_space_data.jobs);
+					out << "]\\n";
+				}
+				out << "}\\nER=";
+				if (n.earliest_job_release() == Time_model::constants<Time>::infinity())
+					out << "N/A";
+				else
+					out << n.earliest_job_release();
+				return out.str();
+			}
+
+			// Adds the nodes of the depth that was just built to the schedule graph,
+			// and the edges that were recorded while building it. Afterwards, the
+			// nodes of the previous depth are no longer needed to collect the graph.
+			void collect_graph_depth()
+			{
+				auto add_node = [this](const Node& n) {
+					graph_node_index[&n] = graph_nodes.size();
+					graph_nodes.push_back(graph_node_label(n));
+				};
+#ifdef CONFIG_PARALLEL
+				for (const Nodes& new_nodes : nodes_storage.back())
+					for (const Node& n : new_nodes)
+						add_node(n);
+				for (Pending_edges& local_edges : pending_edges) {
+#else
+				for (const Node& n : nodes_storage.back())
+					add_node(n);
+				{
+					Pending_edges& local_edges = pending_edges;
+#endif
+					for (const Pending_edge& e : local_edges)
+						edges.emplace_back(e.scheduled, graph_node_index.at(e.source), graph_node_index.at(e.target),
+							e.finish_range, e.parallelism);
+					local_edges.clear();
+				}
+
+				if (nodes_storage.size() > 1) {
+#ifdef CONFIG_PARALLEL
+					for (const Nodes& old_nodes : nodes_storage[nodes_storage.size() - 2])
+						for (const Node& n : old_nodes)
+							graph_node_index.erase(&n);
+#else
+					for (const Node& n : nodes_storage[nodes_storage.size() - 2])
+						graph_node_index.erase(&n);
+#endif
+				}
+			}
+
+			// Rough estimate of the memory used by the nodes of the next depth that
+			// are in memory: the nodes and states themselves, their sets of scheduled
+			// jobs, and the bookkeeping of the containers they are stored in.
+			std::size_t next_front_memory() const
+			{
+				std::size_t node_bytes = sizeof(Node) + 8 * (state_space_data.num_jobs() / 64 + 1) + 64;
+				std::size_t state_bytes = sizeof(State) + 48;
+				return (num_nodes - next_nodes_base) * node_bytes + (num_states - next_states_base) * state_bytes;
+			}
+
+			void check_memory_limit()
+			{
+				if (memory_limit && next_front_memory() > memory_limit)
+					spill_next_front();
+			}
+
+			// Moves all nodes of the next depth that were built so far to disk.
+			// Nodes with the same set of scheduled jobs that are built afterwards
+			// are merged with them when the spilled front is read back.
+			void spill_next_front()
+			{
+				if (!spilled_next)
+					spilled_next.reset(new Spill(spill_dir));
+				unsigned long spilled_before = spilled_next->size();
+#ifdef CONFIG_PARALLEL
+				for (Nodes& new_nodes : nodes_storage.back()) {
+					for (const Node& n : new_nodes)
+						spilled_next->write(n);
+					new_nodes.clear();
+				}
+#else
+				for (const Node& n : nodes_storage.back())
+					spilled_next->write(n);
+				nodes_storage.back().clear();
+#endif
+				state_pools.back().forget_job_sets();
+				num_spilled_nodes += spilled_next->size() - spilled_before;
+				nodes_by_key.clear();
+				next_nodes_base = num_nodes;
+				next_states_base = num_states;
+			}
+
+			// Reads one partition of a spilled front back into the (empty) storage of the
+			// current depth. The nodes that were spilled several times are merged again.
+			// Returns the number of states of the nodes that were read.
+			unsigned long read_spilled_partition(const std::vector<char>& buffer)
+			{
+#ifdef CONFIG_PARALLEL
+				Nodes& front = nodes_storage.front().local();
+#else
+				Nodes& front = nodes_storage.front();
+#endif
+				State_pool<Time>& pool = state_pools.front();
+				std::unordered_multimap<hash_value_t, Node*> read_nodes;
+				unsigned long front_states = 0;
+
+				Spill_reader r(buffer);
+				while (!r.at_end()) {
+					front.emplace_back(r, state_space_data, &pool);
+					Node* n = &front.back();
+					Node* into = n;
+					auto same_key = read_nodes.equal_range(n->get_key());
+					for (auto it = same_key.first; it != same_key.second; it++) {
+						if (it->second->get_scheduled_jobs() == n->get_scheduled_jobs()) {
+							into = it->second;
+							break;
+						}
+					}
+
+					for (std::size_t i = 0, k = r.get<std::size_t>(); i < k; i++) {
+						State* s = pool.create(r);
+						if (into == n) {
+							n->add_state(s);
+							front_states++;
+						}
+						else {
+							// the state was already counted when it was created
+							long delta = merge_or_add_state(*into, *s, pool) - 1;
+							num_states += delta;
+							next_states_base += delta;
+							front_states += delta + 1;
+						}
+					}
+
+					if (into == n)
+						read_nodes.emplace(n->get_key(), n);
+					else {
+						front.pop_back();
+						num_nodes--;
+						next_nodes_base--;
+					}
+				}
+				return front_states;
+			}
+
+			// Explores a front that was moved to disk one partition at a time, such that
+			// only one partition of the current depth is in memory at once, and records
+			// the width of the front.
+			void explore_spilled_front(int& last_num_states)
+			{
+				std::unique_ptr<Spill> front = std::move(spilled_front);
+				std::vector<char> buffer;
+				unsigned long front_nodes = 0;
+				unsigned long front_states = 0;
+				long spilled_states = front->number_of_states();
+
+				for (unsigned int p = 0; p < Spill::num_partitions && !aborted; p++) {
+					if (!front->size(p))
+						continue;
+					front->read(p, buffer);
+					front_states += read_spilled_partition(buffer);
+#ifdef CONFIG_PARALLEL
+					for (const Nodes& part : nodes_storage.front())
+						front_nodes += part.size();
+					explore_front(nodes_storage.front());
+					check_memory_limit();
+					for (Nodes& part : nodes_storage.front())
+						part.clear();
+#else
+					front_nodes += nodes_storage.front().size();
+					for (const Node& n : nodes_storage.front()) {
+						explore(n);
+						check_memory_limit();
+						check_cpu_timeout();
+						if (aborted)
+							break;
+					}
+					nodes_storage.front().clear();
+#endif
+					state_pools.front().forget_job_sets();
+				}
+
+				max_width = std::max(max_width, front_nodes);
+				width[current_job_count] = { front_nodes, front_states };
+				// as if the merges of the nodes that were read back happened in the previous depth
+				last_num_states += (long)front_states - spilled_states;
+			}
+
+			void merge_spilled_front()
+			{
+				std::unique_ptr<Spill> front = std::move(spilled_front);
+				std::vector<char> buffer;
+				for (unsigned int p = 0; p < Spill::num_partitions; p++) {
+					if (!front->size(p))
+						continue;
+					front->read(p, buffer);
+					read_spilled_partition(buffer);
+#ifdef CONFIG_PARALLEL
+					for (Nodes& part : nodes_storage.back())
+						part.clear();
+#else
+					nodes_storage.back().clear();
+#endif
+					state_pools.back().forget_job_sets();
+				}
+			}
+
+			// identifies the problem and the options that influence the result,
+			// such that a checkpoint is only resumed by the same analysis
+			hash_value_t checkpoint_fingerprint() const
+			{
+				hash_value_t h = 0xCBF29CE484222325ULL;
+				auto add = [&h](hash_value_t v) {
+					h = (h ^ v) * 0x100000001B3ULL;
+				};
+				add(sizeof(Time));
+				add(num_cpus);
+				add(state_space_data.num_jobs());
+				for (const Job<Time>& j : state_space_data.jobs)
+					add(j.get_key());
+				add(merge_opts.conservative);
+				add(merge_opts.use_finish_times);
+				add(merge_opts.budget);
+				add(early_exit);
+				// the node keys are stored in the checkpoint
+				add(state_space_data.has_zobrist_keys());
+				return h;
+			}
+
+			// the response times found so far by all threads
+			Response_times response_times_so_far()
+			{
+				Response_times r = rta;
+#ifdef CONFIG_PARALLEL
+				for (const Response_times& partial : partial_rta)
+					for (Job_index i = 0; i < partial.size(); i++)
+						if (partial[i].valid)
+							update_finish_times(r, i, partial[i].rt);
+#endif
+				return r;
+			}
+
+			// Writes everything needed to continue the exploration from the front of the
+			// current depth, before it is explored (see checkpoint.hpp for the layout).
+			void write_checkpoint(int last_num_states)
+			{
+				Checkpoint::Writer out(checkpoint_file);
+				Spill_writer w;
+				unsigned long edges_so_far = num_edges;
+#ifdef CONFIG_PARALLEL
+				for (unsigned long c : edge_counter)
+					edges_so_far += c;
+#endif
+				w.put(checkpoint_fingerprint());
+				w.put(current_job_count);
+				w.put((unsigned long)num_nodes);
+				w.put((unsigned long)num_states);
+				w.put(edges_so_far);
+				w.put(max_width);
+				w.put(num_spilled_nodes);
+				w.put(last_num_states);
+				w.put(get_cpu_time());
+				w.put((bool)observed_deadline_miss);
+				for (const auto& wd : width) {
+					w.put(wd.first);
+					w.put(wd.second);
+				}
+				for (const Response_time_item& r : response_times_so_far()) {
+					w.put(r.valid);
+					w.put(r.rt.min());
+					w.put(r.rt.max());
+				}
+
+				w.put(spilled_front != nullptr);
+				if (spilled_front) {
+					w.put(spilled_front->size());
+					out.write(w);
+					// the nodes are already serialized in the spill files
+					std::vector<char> buffer;
+					for (unsigned int p = 0; p < Spill::num_partitions; p++) {
+						spilled_front->read(p, buffer);
+						out.write(buffer.data(), buffer.size());
+					}
+				}
+				else {
+					unsigned long n = 0;
+#ifdef CONFIG_PARALLEL
+					for (const Nodes& part : nodes_storage.back())
+						n += part.size();
+#else
+					n = nodes_storage.back().size();
+#endif
+					w.put(n);
+					out.write(w);
+					auto write_node = [&](const Node& node) {
+						w.clear();
+						node.write_to(w);
+						out.write(w);
+					};
+#ifdef CONFIG_PARALLEL
+					for (const Nodes& part : nodes_storage.back())
+						for (const Node& node : part)
+							write_node(node);
+#else
+					for (const Node& node : nodes_storage.back())
+						write_node(node);
+#endif
+				}
+				out.commit();
+				last_checkpoint_depth = current_job_count;
+			}
+
+			// Restores the exploration from the checkpoint, if there is one.
+			bool load_checkpoint(int& last_num_states)
+			{
+				Mapped_file file(checkpoint_file);
+				if (!file.exists())
+					return false;
+
+				Spill_reader r(file.begin(), file.end());
+				Checkpoint::check_header(r, checkpoint_file);
+				if (r.get<hash_value_t>() != checkpoint_fingerprint())
+					throw std::runtime_error(checkpoint_file + " is a checkpoint of another problem or of other analysis options");
+
+				current_job_count = r.get<unsigned long>();
+				num_nodes = r.get<unsigned long>();
+				num_states = r.get<unsigned long>();
+				num_edges = r.get<unsigned long>();
+				max_width = r.get<unsigned long>();
+				num_spilled_nodes = r.get<unsigned long>();
+				last_num_states = r.get<int>();
+				cpu_time_before_resume = r.get<double>();
+				observed_deadline_miss = r.get<bool>();
+				for (auto& wd : width) {
+					wd.first = r.get<unsigned long>();
+					wd.second = r.get<unsigned long>();
+				}
+				for (Response_time_item& rt : rta) {
+					rt.valid = r.get<bool>();
+					Time min = r.get<Time>();
+					rt.rt = Interval<Time>(min, r.get<Time>());
+				}
+
+				state_pools.emplace_back();
+				nodes_storage.emplace_back();
+				bool spilled = r.get<bool>();
+				if (spilled)
+					spilled_front.reset(new Spill(spill_dir));
+				for (unsigned long i = 0, n = r.get<unsigned long>(); i < n; i++) {
+					nodes().emplace_back(r, state_space_data, &state_pools.back());
+					Node& node = nodes().back();
+					for (std::size_t k = r.get<std::size_t>(); k > 0; k--)
+						node.add_state(state_pools.back().create(r));
+					if (spilled) {
+						spilled_front->write(node);
+						nodes().pop_back();
+					}
+				}
+				if (!r.at_end())
+					throw std::runtime_error(checkpoint_file + " is corrupted");
+
+				resumed_depth = last_checkpoint_depth = current_job_count;
+				return true;
+			}
+
+			// Periodic job sets (see periodic.hpp): if every state of the front, shifted back by
+			// one hyperperiod, is covered by a state of the front one hyperperiod's worth of jobs
+			// earlier, then what remains to be explored is (covered by) what was explored since
+			// that front, shifted by one hyperperiod, and so on until the last job.
+			bool check_periodic_front() const
+			{
+				if (recent_fronts.empty() || current_job_count < periodic->jobs_per_period()
+					|| recent_fronts.front().depth != current_job_count - periodic->jobs_per_period())
+					return false;
+
+				const Front_snapshot& past = recent_fronts.front();
+				bool repeats = true;
+				auto check_node = [&](const Node& n) {
+					if (!repeats)
+						return;
+					auto it = past.by_key.find(n.get_key());
+					const typename Front_snapshot::Entry* match = nullptr;
+					if (it != past.by_key.end())
+						for (const auto& e : it->second)
+							if (e.jobs.is_subset_of(n.get_scheduled_jobs()) && n.get_scheduled_jobs().is_subset_of(e.jobs))
+								match = &e;
+					if (!match) {
+						repeats = false;
+						return;
+					}
+					std::deque<State> past_states;
+					Spill_reader r(past.states.data() + match->first_state, past.states.data() + past.states.size());
+					for (std::size_t i = 0; i < match->num_states; i++)
+						past_states.emplace_back(r);
+					for (const State* s : *n.get_states())
+						if (std::none_of(past_states.begin(), past_states.end(), [&](const State& p) {
+								return p.covers_shifted(*s, periodic->get_hyperperiod(), periodic->earlier_counterparts());
+							})) {
+							repeats = false;
+							return;
+						}
+				};
+#ifdef CONFIG_PARALLEL
+				for (const Nodes& part : nodes_storage.back())
+					for (const Node& n : part)
+						check_node(n);
+#else
+				for (const Node& n : nodes_storage.back())
+					check_node(n);
+#endif
+				return repeats;
+			}
+
+			// keep the front of the current depth, shifted by one hyperperiod, for check_periodic_front()
+			void snapshot_periodic_front()
+			{
+				recent_fronts.emplace_back();
+				Front_snapshot& f = recent_fronts.back();
+				f.depth = current_job_count;
+				auto add_node = [&](const Node& n) {
+					Job_set jobs;
+					hash_value_t key;
+					// a node with jobs of the last hyperperiod cannot repeat an earlier one
+					if (!periodic->shift(n.get_scheduled_jobs(), state_space_data, jobs, key))
+						return;
+					auto& e = f.by_key[key].emplace_back();
+					e.jobs.copy_from(jobs);
+					e.num_states = n.states_size();
+					e.first_state = f.states.size();
+					for (const State* s : *n.get_states())
+						s->write_to(f.states);
+				};
+#ifdef CONFIG_PARALLEL
+				for (const Nodes& part : nodes_storage.back())
+					for (const Node& n : part)
+						add_node(n);
+#else
+				for (const Node& n : nodes_storage.back())
+					add_node(n);
+#endif
+				if (recent_fronts.size() > periodic->jobs_per_period())
+					recent_fronts.pop_front();
+			}
+
+			// keep the finish times found while exploring the current depth
+			void end_periodic_depth()
+			{
+				recent_finish_times.emplace_back();
+				auto collect = [this](Depth_finish_times& d) {
+					for (Job_index j : d.found) {
+						recent_finish_times.back().emplace_back(j, d.rt[j].rt);
+						d.rt[j].valid = false;
+					}
+					d.found.clear();
+				};
+#ifdef CONFIG_PARALLEL
+				for (Depth_finish_times& d : depth_finish_times)
+					collect(d);
+#else
+				collect(depth_finish_times);
+#endif
+				if (recent_finish_times.size() > periodic->jobs_per_period())
+					recent_finish_times.pop_front();
+			}
+
+			// Once the exploration repeats itself (see check_periodic_front), a job finishes
+			// from the current depth on at most when its earlier counterpart finished in the
+			// last hyperperiod's worth of depths or from the current depth on, shifted by
+			// one hyperperiod. The jobs of the first hyperperiod are all scheduled already.
+			void project_periodic_finish_times()
+			{
+				const Time hyperperiod = periodic->get_hyperperiod();
+				auto shift = [hyperperiod](const Interval<Time>& i) {
+					return Interval<Time>{ i.min() + hyperperiod, i.max() + hyperperiod };
+				};
+				Response_times recent(state_space_data.num_jobs()), projected(state_space_data.num_jobs());
+				for (const auto& depth : recent_finish_times)
+					for (const auto& ft : depth)
+						update_finish_times(recent, ft.first, ft.second);
+
+				for (Job_index j : periodic->jobs_by_arrival()) {
+					Job_index e = periodic->earlier_counterpart(j);
+					if (e == Periodic_jobs<Time>::none)
+						continue;
+					if (recent[e].valid)
+						update_finish_times(projected, j, shift(recent[e].rt));
+					if (projected[e].valid)
+						update_finish_times(projected, j, shift(projected[e].rt));
+					if (!projected[j].valid)
+						continue;
+					update_finish_times(rta, j, projected[j].rt);
+					if (state_space_data.jobs[j].exceeds_deadline(projected[j].rt.upto())) {
+						observed_deadline_miss = true;
+						if (early_exit)
+							aborted = true;
+					}
+				}
+			}
+
+			// A segment of the jobs and its analysis (which refers to the jobs of the segment).
+			struct Segment_analysis {
+				Problem problem;
+				std::unique_ptr<State_space> result;
+
+				Segment_analysis(const Problem& prob, const Idle_point_decomposition<Time>& segments, std::size_t k)
+					: problem(segments.segment_problem(prob, k))
+				{
+				}
+			};
+
+			// Analyses the segments of the idle-point decomposition separately (in parallel
+			// if possible), and combines their results. The decomposition is only valid if
+			// the jobs of each segment certainly finish before the next segment may start:
+			// any segment for which this cannot be shown is merged with the next one, and
+			// the merged segment is analysed again.
+			void explore_segments(const Problem& prob, const Analysis_options& opts,
+				Idle_point_decomposition<Time>& segments)
+			{
+				// without early exit, the finish times of all jobs of a segment are known
+				Analysis_options segment_opts = opts;
+				segment_opts.decompose = false;
+				segment_opts.early_exit = false;
+				segment_opts.verbose = false;
+
+				typedef std::pair<std::size_t, std::size_t> Bounds;
+				std::map<Bounds, std::unique_ptr<Segment_analysis>> analyses;
+				auto bounds_of = [&segments](std::size_t k) {
+					return Bounds(segments.boundaries[k], segments.boundaries[k + 1]);
+				};
+
+				while (true) {
+					std::vector<std::size_t> todo;
+					for (std::size_t k = 0; k < segments.number_of_segments(); k++)
+						if (!analyses.count(bounds_of(k)))
+							todo.push_back(k);
+
+					std::vector<std::unique_ptr<Segment_analysis>> done(todo.size());
+					auto analyse = [&](std::size_t i) {
+						done[i].reset(new Segment_analysis(prob, segments, todo[i]));
+						done[i]->result.reset(explore(done[i]->problem, segment_opts));
+					};
+#ifdef CONFIG_PARALLEL
+					tbb::parallel_for((std::size_t)0, todo.size(), analyse);
+#else
+					for (std::size_t i = 0; i < todo.size(); i++)
+						analyse(i);
+#endif
+					for (std::size_t i = 0; i < todo.size(); i++)
+						analyses[bounds_of(todo[i])] = std::move(done[i]);
+
+					// a segment that was not completely explored refutes nothing
+					bool out_of_time = timeout && get_cpu_time() > timeout;
+					for (std::size_t k = 0; k < segments.number_of_segments(); k++)
+						out_of_time |= analyses[bounds_of(k)]->result->was_timed_out();
+					if (out_of_time) {
+						timed_out = true;
+						aborted = true;
+						break;
+					}
+
+					bool merged = false;
+					for (std::size_t k = segments.number_of_segments() - 1; k-- > 0;) {
+						const State_space& left = *analyses[bounds_of(k)]->result;
+						Time idle_point = segments.idle_point(prob, k);
+						bool finishes = !left.aborted;
+						for (Job_index j = 0; finishes && j < left.rta.size(); j++)
+							finishes = left.get_finish_times(j).max() <= idle_point;
+						if (!finishes) {
+							segments.merge(k);
+							merged = true;
+						}
+					}
+					if (!merged)
+						break;
+				}
+
+				num_segments = segments.number_of_segments();
+				for (std::size_t k = 0; k < num_segments; k++) {
+					const State_space& r = *analyses[bounds_of(k)]->result;
+					std::vector<Job_index> jobs = segments.segment_jobs(k);
+					for (std::size_t i = 0; i < jobs.size(); i++)
+						rta[jobs[i]] = r.rta[i];
+					num_nodes += r.num_nodes;
+					num_states += r.num_states;
+					num_edges += r.num_edges;
+					num_merge_calls += r.num_merge_calls;
+					num_merge_attempts += r.num_merge_attempts;
+					max_node_merge_attempts = std::max<unsigned long>(max_node_merge_attempts, r.max_node_merge_attempts);
+					num_key_matches += r.num_key_matches;
+					num_key_collisions += r.num_key_collisions;
+					num_spilled_nodes += r.num_spilled_nodes;
+					// the nodes of depth d of segment k are the nodes of depth
+					// first + d of the whole problem
+					std::size_t first = segments.boundaries[k];
+					for (std::size_t d = 0; d < r.width.size(); d++)
+						width[first + d] = r.width[d];
+#ifdef CONFIG_PARALLEL
+					for (std::size_t d = 0; d < r.thread_utilization.size(); d++)
+						thread_utilization[first + d] = r.thread_utilization[d];
+#endif
+					max_width = std::max(max_width, r.max_width);
+					aborted |= r.aborted;
+					timed_out |= r.timed_out;
+					observed_deadline_miss |= r.observed_deadline_miss;
+				}
+				current_job_count = state_space_data.num_jobs();
+			}
+
 			void explore()
 			{
 				int last_time;
@@ -930,7 +2110,11 @@ namespace NP {
 				}
 
 				int last_num_states = 0;
-				make_initial_node(num_cpus);
+				if (!resume || checkpoint_file.empty() || !load_checkpoint(last_num_states))
+					make_initial_node(num_cpus);
+				if (collect_graph)
+					collect_graph_depth();
+				next_checkpoint_time = get_cpu_time() + checkpoint_interval;
 
 				while (current_job_count < state_space_data.num_jobs()) {
 					unsigned long n;
@@ -944,17 +2128,43 @@ namespace NP {
 					Nodes& exploration_front = nodes();
 					n = exploration_front.size();
 #endif
+					if (spilled_front)
+						n += spilled_front->size();
 					if (n == 0)
 					{
 						aborted = true;
 						break;
 					}
-					// allocate node space for next depth
-					nodes_storage.emplace_back();
 
-					// keep track of exploration front width
-					max_width = std::max(max_width, n);
-					width[current_job_count] = { n, num_states - last_num_states };
+					// (not if the previous depth was not completely explored)
+					if (!checkpoint_file.empty() && !aborted && current_job_count > last_checkpoint_depth
+						&& get_cpu_time() >= next_checkpoint_time) {
+						write_checkpoint(last_num_states);
+						next_checkpoint_time = get_cpu_time() + checkpoint_interval;
+					}
+
+					// stop once the exploration repeats itself one hyperperiod later
+					// (a spilled front is neither compared nor kept)
+					if (periodic && !spilled_front && !aborted) {
+						if (check_periodic_front()) {
+							periodic_depth = current_job_count;
+							break;
+						}
+						snapshot_periodic_front();
+					}
+
+					// allocate node and state space for next depth
+					state_pools.emplace_back();
+					nodes_storage.emplace_back();
+					next_nodes_base = num_nodes;
+					next_states_base = num_states;
+
+					// keep track of exploration front width (of a spilled front
+					// once it has been read back, see explore_spilled_front)
+					if (!spilled_front) {
+						max_width = std::max(max_width, n);
+						width[current_job_count] = { n, num_states - last_num_states };
+					}
 					last_num_states = num_states;
 
 					if (verbose) {
@@ -970,29 +2180,38 @@ namespace NP {
 					if (aborted)
 						break;
 
+					if (spilled_front)
+						explore_spilled_front(last_num_states);
+					else {
 #ifdef CONFIG_PARALLEL
+						explore_front(new_nodes_part);
+#else
+						for (const Node& n : exploration_front) {
+							explore(n);
+							check_memory_limit();
+							check_cpu_timeout();
+							if (aborted)
+								break;
+						}
+#endif
+					}
 
-					parallel_for(new_nodes_part.range(),
-						[&](typename Split_nodes::const_range_type& r) {
-							for (auto it = r.begin(); it != r.end(); it++) {
-								const Nodes& new_nodes = *it;
-								auto s = new_nodes.size();
-								tbb::parallel_for(tbb::blocked_range<size_t>(0, s),
-									[&](const tbb::blocked_range<size_t>& r) {
-										for (size_t i = r.begin(); i != r.end(); i++)
-											explore(new_nodes[i]);
-									});
-							}
-						});
+					if (sort_frontier)
+						build_frontier_by_sorting();
 
-#else
-					for (const Node& n : exploration_front) {
-						explore(n);
-						check_cpu_timeout();
-						if (aborted)
-							break;
+					if (periodic)
+						end_periodic_depth();
+
+					if (collect_graph)
+						collect_graph_depth();
+
+					// once part of the next depth was spilled, all of it is, such
+					// that it can be explored partition by partition
+					if (memory_limit && !aborted) {
+						if (spilled_next || next_front_memory() > memory_limit)
+							spill_next_front();
+						spilled_front = std::move(spilled_next);
 					}
-#endif
 
 					// clean up the state cache if necessary
 					if (!be_naive)
@@ -1000,10 +2219,8 @@ namespace NP {
 
 					current_job_count++;
 
-#ifndef CONFIG_COLLECT_SCHEDULE_GRAPH
-					// If we don't need to collect all nodes, we can remove
-					// all those that we are done with, which saves a lot of
-					// memory.
+					// remove the nodes that we are done with, which saves
+					// a lot of memory
 #ifdef CONFIG_PARALLEL
 					parallel_for(nodes_storage.front().range(),
 						[](typename Split_nodes::range_type& r) {
@@ -1012,12 +2229,18 @@ namespace NP {
 						});
 #endif
 					nodes_storage.pop_front();
-#endif
-
+					// all states of the retired depth were released with their nodes,
+					// so its slabs can be freed in bulk
+					state_pools.pop_front();
 				}
 				if (verbose)
 					std::cout << "\r100%" << std::endl << "Terminating" << std::endl;
 
+				// the nodes of the last depth that were spilled several times
+				// must still be merged to be counted once
+				if (spilled_front && !aborted)
+					merge_spilled_front();
+
 				if (reconfiguration_agent) {
 					for (const Node& n : nodes()) reconfiguration_agent->mark_as_leaf_node(n);
 				}
@@ -1032,8 +2255,10 @@ namespace NP {
 				}
 #endif
 
+				if (periodic_depth)
+					project_periodic_finish_times();
+
 
-#ifndef CONFIG_COLLECT_SCHEDULE_GRAPH
 				// clean out any remaining nodes
 				while (!nodes_storage.empty()) {
 #ifdef CONFIG_PARALLEL
@@ -1044,66 +2269,31 @@ namespace NP {
 						});
 #endif
 					nodes_storage.pop_front();
+					state_pools.pop_front();
 				}
-#endif
 
 #ifdef CONFIG_PARALLEL
 				for (auto& c : edge_counter)
 					num_edges += c;
 #endif
+
+				// a complete analysis does not need to be resumed
+				if (!checkpoint_file.empty() && !interrupted)
+					std::remove(checkpoint_file.c_str());
 			}
 
 
-#ifdef CONFIG_COLLECT_SCHEDULE_GRAPH
 			friend std::ostream& operator<< (std::ostream& out,
 				const State_space<Time>& space)
 			{
-				std::map<const Schedule_node<Time>*, unsigned int> node_id;
-				unsigned int i = 0;
 				out << "digraph {" << std::endl;
-#ifdef CONFIG_PARALLEL
-				for (const Split_nodes& nodes : space.get_nodes()) {
-					for (const Schedule_node<Time>& n : tbb::flattened2d<Split_nodes>(nodes)) {
-#else
-				for (const auto& front : space.get_nodes()) {
-					for (const Schedule_node<Time>& n : front) {
-#endif
-						/*node_id[&n] = i++;
-						out << "\tS" << node_id[&n]
-							<< "[label=\"S" << node_id[&n] << ": ";
-						n.print_vertex_label(out, space.jobs);
-						out << "\"];" << std::endl;*/
-						node_id[&n] = i++;
-						out << "\tN" << node_id[&n]
-							<< "[label=\"N" << node_id[&n] << ": {";
-						const auto* n_states = n.get_states();
-
-						for (State* s : *n_states)
-						{
-							out << "[";
-							s->print_vertex_label(out, space.state_space_data.jobs);
-							//<< s->earliest_finish_time()
-							//<< ", "
-							//<< s->latest_finish_time()
-							out << "]\\n";
-						}
-						out << "}"
-							<< "\\nER=";
-						if (n.earliest_job_release() ==
-							Time_model::constants<Time>::infinity()) {
-							out << "N/A";
-						}
-						else {
-							out << n.earliest_job_release();
-						}
-						out << "\"];"
-							<< std::endl;
-					}
-				}
+				const auto& nodes = space.get_graph_nodes();
+				for (unsigned long i = 0; i < nodes.size(); i++)
+					out << "\tN" << i << "[label=\"N" << i << ": " << nodes[i] << "\"];" << std::endl;
 				for (const auto& e : space.get_edges()) {
-					out << "\tN" << node_id[e.source]
+					out << "\tN" << e.source
 						<< " -> "
-						<< "N" << node_id[e.target]
+						<< "N" << e.target
 						<< "[label=\""
 						<< "T" << e.scheduled->get_task_id()
 						<< " J" << e.scheduled->get_job_id()
@@ -1120,7 +2310,7 @@ namespace NP {
 						<< ";"
 						<< std::endl;
 					if (e.deadline_miss_possible()) {
-						out << "N" << node_id[e.target]
+						out << "N" << e.target
 							<< "[color=Red];"
 							<< std::endl;
 					}
@@ -1128,7 +2318,6 @@ namespace NP {
 				out << "}" << std::endl;
 				return out;
 					}
-#endif
 				};
 
 			}
@@ -0,0 +1,219 @@
+#ifndef GLOBAL_SPILL_HPP
+#define GLOBAL_SPILL_HPP
+
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#ifndef _WIN32
+#include <stdlib.h>
+#include <unistd.h>
+#endif
+
+#include "jobs.hpp"
+
+namespace NP {
+
+	namespace Global {
+
+		// Buffer into which nodes and states are serialized before they are
+		// written to a spill file (see Schedule_node::write_to()).
+		class Spill_writer
+		{
+			std::vector<char> buffer;
+
+		public:
+
+			template<typename T> void put(const T& value)
+			{
+				static_assert(std::is_trivially_copyable<T>::value, "only plain values can be spilled");
+				const char* bytes = reinterpret_cast<const char*>(&value);
+				buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+			}
+
+			const char* data() const
+			{
+				return buffer.data();
+			}
+
+			std::size_t size() const
+			{
+				return buffer.size();
+			}
+
+			void clear()
+			{
+				buffer.clear();
+			}
+		};
+
+		// Reads back the values written by a Spill_writer, in the same order.
+		class Spill_reader
+		{
+			const char* pos;
+			const char* end;
+
+		public:
+
+			Spill_reader(const std::vector<char>& buffer)
+				: pos(buffer.data())
+				, end(buffer.data() + buffer.size())
+			{
+			}
+
+			Spill_reader(const char* begin, const char* end)
+				: pos(begin)
+				, end(end)
+			{
+			}
+
+			template<typename T> T get()
+			{
+				static_assert(std::is_trivially_copyable<T>::value, "only plain values can be spilled");
+				if (pos + sizeof(T) > end)
+					throw std::runtime_error("truncated spill file");
+				T value;
+				std::memcpy(&value, pos, sizeof(T));
+				pos += sizeof(T);
+				return value;
+			}
+
+			bool at_end() const
+			{
+				return pos == end;
+			}
+		};
+
+		// The nodes of one depth of the exploration that were moved out of memory.
+		// The nodes are partitioned by (the top bits of) their lookup key, such that
+		// all nodes with the same set of scheduled jobs end up in the same partition.
+		// The partitions can thus be read back and merged one at a time.
+		//
+		// The files are anonymous temporary files, either in the default temporary
+		// directory or in the given one (not on Windows); they are removed when closed.
+		template<class Node> class Spilled_front
+		{
+		public:
+
+			static constexpr unsigned int partition_bits = 6;
+			static constexpr unsigned int num_partitions = 1 << partition_bits;
+
+		private:
+
+			std::array<std::FILE*, num_partitions> files;
+			std::array<unsigned long, num_partitions> nodes_in;
+			std::string dir;
+			unsigned long num_nodes;
+			unsigned long num_states;
+			unsigned long long num_bytes;
+			Spill_writer writer;
+
+			static unsigned int partition_of(hash_value_t key)
+			{
+				return (unsigned int)(key >> (8 * sizeof(hash_value_t) - partition_bits));
+			}
+
+			std::FILE* open_file() const
+			{
+#ifndef _WIN32
+				if (!dir.empty()) {
+					std::string path = dir + "/np-spill-XXXXXX";
+					int fd = mkstemp(&path[0]);
+					if (fd < 0)
+						return nullptr;
+					// the file stays accessible through fd until it is closed
+					unlink(path.c_str());
+					return fdopen(fd, "w+b");
+				}
+#endif
+				return std::tmpfile();
+			}
+
+			// no accidental copies
+			Spilled_front(const Spilled_front& origin) = delete;
+
+		public:
+
+			Spilled_front(const std::string& dir = "")
+				: dir(dir)
+				, num_nodes(0)
+				, num_states(0)
+				, num_bytes(0)
+			{
+				files.fill(nullptr);
+				nodes_in.fill(0);
+			}
+
+			~Spilled_front()
+			{
+				for (std::FILE* f : files)
+					if (f)
+						std::fclose(f);
+			}
+
+			// append node n to the partition of its key
+			void write(const Node& n)
+			{
+				unsigned int p = partition_of(n.get_key());
+				if (!files[p] && !(files[p] = open_file()))
+					throw std::runtime_error("could not create a spill file");
+
+				writer.clear();
+				n.write_to(writer);
+				if (std::fwrite(writer.data(), 1, writer.size(), files[p]) != writer.size())
+					throw std::runtime_error("could not write to a spill file");
+				nodes_in[p]++;
+				num_nodes++;
+				num_states += n.states_size();
+				num_bytes += writer.size();
+			}
+
+			// read the whole partition p into buffer
+			void read(unsigned int p, std::vector<char>& buffer)
+			{
+				buffer.clear();
+				if (!files[p])
+					return;
+				long size = std::ftell(files[p]);
+				buffer.resize(size);
+				std::rewind(files[p]);
+				if (std::fread(buffer.data(), 1, size, files[p]) != (std::size_t)size)
+					throw std::runtime_error("could not read a spill file");
+			}
+
+			// the number of nodes written to partition p
+			unsigned long size(unsigned int p) const
+			{
+				return nodes_in[p];
+			}
+
+			// the number of nodes written to all partitions
+			unsigned long size() const
+			{
+				return num_nodes;
+			}
+
+			// the number of states of all nodes written
+			unsigned long number_of_states() const
+			{
+				return num_states;
+			}
+
+			bool empty() const
+			{
+				return num_nodes == 0;
+			}
+
+			unsigned long long bytes_written() const
+			{
+				return num_bytes;
+			}
+		};
+	}
+}
+
+#endif
@@ -2,17 +2,26 @@
 #define GLOBAL_STATE_HPP
 #include <algorithm>
 #include <cassert>
+#include <deque>
 #include <iostream>
 #include <ostream>
 
-#include <set>
-
 #include "config.h"
+
+#ifdef CONFIG_PARALLEL
+#include "tbb/enumerable_thread_specific.h"
+#include "tbb/spin_mutex.h"
+#endif
+
 #include "cache.hpp"
 #include "index_set.hpp"
 #include "jobs.hpp"
+#include "object_pool.hpp"
 #include "statistics.hpp"
 #include "util.hpp"
+#include "global/availability_intervals.hpp"
+#include "global/sorted_states.hpp"
+#include "global/spill.hpp"
 #include "global/state_space_data.hpp"
 #include "reconfiguration/attachment.hpp"
 
@@ -41,7 +50,7 @@ namespace NP {
 				) : job_index(job_index), start_times(start_times), finish_times(finish_times) {}
 			};
 			typedef std::vector<Single_job_times> Job_times;
-			typedef std::vector<Interval<Time>> Core_availability;
+			typedef Availability_intervals<Time> Core_availability;
 			typedef typename State_space_data<Time>::Suspensions_list Susp_list;
 			typedef std::vector<Susp_list> Successors;
 			typedef std::vector<Susp_list> Predecessors;
@@ -128,6 +137,59 @@ namespace NP {
 				DM("*** new state: constructed " << *this << std::endl);
 			}
 
+			// state read back from a spill file (see write_to())
+			Schedule_state(Spill_reader& r)
+				: earliest_certain_successor_job_disptach{ r.get<Time>() }
+				, earliest_certain_gang_source_job_disptach{ r.get<Time>() }
+			{
+				unsigned int ncores = r.get<unsigned int>();
+				core_avail.reserve(ncores);
+				for (unsigned int i = 0; i < ncores; i++) {
+					Time min = r.get<Time>();
+					core_avail.emplace_back(min, r.get<Time>());
+				}
+
+				certain_jobs.resize(r.get<std::size_t>(), Running_job{ 0, Parallelism(0, 0), Interval<Time>(0, 0) });
+				for (Running_job& rj : certain_jobs) {
+					rj.idx = r.get<Job_index>();
+					rj.parallelism = read_interval<unsigned int>(r);
+					rj.finish_time = read_interval<Time>(r);
+				}
+
+				job_times.resize(r.get<std::size_t>(), Single_job_times{ 0, Interval<Time>(0, 0), Interval<Time>(0, 0) });
+				for (Single_job_times& jt : job_times) {
+					jt.job_index = r.get<Job_index>();
+					jt.start_times = read_interval<Time>(r);
+					jt.finish_times = read_interval<Time>(r);
+				}
+			}
+
+			// serialize the state such that it can be moved out of memory
+			void write_to(Spill_writer& w) const
+			{
+				w.put(earliest_certain_successor_job_disptach);
+				w.put(earliest_certain_gang_source_job_disptach);
+				w.put(core_avail.size());
+				for (unsigned int i = 0; i < core_avail.size(); i++) {
+					w.put(core_avail[i].min());
+					w.put(core_avail[i].max());
+				}
+
+				w.put(certain_jobs.size());
+				for (const Running_job& rj : certain_jobs) {
+					w.put(rj.idx);
+					write_interval(w, rj.parallelism);
+					write_interval(w, rj.finish_time);
+				}
+
+				w.put(job_times.size());
+				for (const Single_job_times& jt : job_times) {
+					w.put(jt.job_index);
+					write_interval(w, jt.start_times);
+					write_interval(w, jt.finish_times);
+				}
+			}
+
 			Interval<Time> core_availability(unsigned long p = 1) const
 			{
 				assert(core_avail.size() > 0);
@@ -189,31 +251,17 @@ namespace NP {
 				// the interval of the other state.
 				// If conservative is false, the a simple overlap or contiguity between inverals is enough
 				if (conservative) {
-					bool overlap = true;
 					// check if all availability intervals of other are within the intervals of this
-					for (int i = 0; i < core_avail.size(); i++) {
-						if (!core_avail[i].contains(other[i])) {
-							overlap = false;
-							break;
-						}
-					}
-					if (overlap == true) {
+					if (core_avail.contains(other)) {
 						other_in_this = true;
 						return true;
 					}
 					// check if all availability intervals of this are within the intervals of other
-					for (int i = 0; i < core_avail.size(); i++) {
-						if (!other[i].contains(core_avail[i])) {
-							return false;;
-						}
-					}
+					return other.contains(core_avail);
 				}
 				else {
-					for (int i = 0; i < core_avail.size(); i++)
-						if (!core_avail[i].intersects(other[i]))
-							return false;
+					return core_avail.intersects(other);
 				}
-				return true;
 			}
 
 			// check if 'other' state can merge with this state
@@ -244,6 +292,83 @@ namespace NP {
 					return false;
 			}
 
+			// true if this state dominates 'other', i.e., if every future of 'other' is a future
+			// of this state: merging 'other' into this state would leave this state unchanged
+			bool dominates(const Schedule_state<Time>& other) const
+			{
+				if (!core_avail.contains(other.core_avail))
+					return false;
+
+				// jobs are certainly ready no earlier
+				if (earliest_certain_successor_job_disptach < other.earliest_certain_successor_job_disptach
+					|| earliest_certain_gang_source_job_disptach < other.earliest_certain_gang_source_job_disptach)
+					return false;
+
+				// same jobs with wider start and finish times (both lists are sorted by job index)
+				if (job_times.size() != other.job_times.size())
+					return false;
+				for (std::size_t i = 0; i < job_times.size(); i++)
+					if (job_times[i].job_index != other.job_times[i].job_index
+						|| !job_times[i].start_times.contains(other.job_times[i].start_times)
+						|| !job_times[i].finish_times.contains(other.job_times[i].finish_times))
+						return false;
+
+				// fewer certainly running jobs with wider finish times (both lists are sorted by job index)
+				auto jt = other.certain_jobs.begin();
+				for (const Running_job& rj : certain_jobs) {
+					while (jt != other.certain_jobs.end() && jt->idx < rj.idx)
+						jt++;
+					if (jt == other.certain_jobs.end() || jt->idx != rj.idx
+						|| !rj.parallelism.contains(jt->parallelism) || !rj.finish_time.contains(jt->finish_time))
+						return false;
+				}
+				return true;
+			}
+
+			// true if this state covers 'later' shifted back by 'offset', where the jobs of 'later'
+			// are renamed by 'earlier' (see Periodic_jobs), i.e., if merging the shifted 'later'
+			// into this state would leave this state unchanged
+			bool covers_shifted(const Schedule_state<Time>& later, Time offset, const std::vector<Job_index>& earlier) const
+			{
+				auto shift = [offset](Time t) {
+					return t == Time_model::constants<Time>::infinity() ? t : t - offset;
+				};
+				auto shift_interval = [&shift](const Interval<Time>& i) {
+					return Interval<Time>{ shift(i.min()), shift(i.max()) };
+				};
+
+				assert(core_avail.size() == later.core_avail.size());
+				for (unsigned int i = 0; i < core_avail.size(); i++)
+					if (!core_avail[i].contains(shift_interval(later.core_avail[i])))
+						return false;
+
+				if (earliest_certain_successor_job_disptach < shift(later.earliest_certain_successor_job_disptach)
+					|| earliest_certain_gang_source_job_disptach < shift(later.earliest_certain_gang_source_job_disptach))
+					return false;
+
+				// same jobs with wider start and finish times
+				if (job_times.size() != later.job_times.size())
+					return false;
+				for (const Single_job_times& jt : later.job_times) {
+					Job_index j = earlier[jt.job_index];
+					int offset = jft_find(j);
+					if (offset >= job_times.size() || job_times[offset].job_index != j
+						|| !job_times[offset].start_times.contains(shift_interval(jt.start_times))
+						|| !job_times[offset].finish_times.contains(shift_interval(jt.finish_times)))
+						return false;
+				}
+
+				// fewer certainly running jobs with wider finish times
+				for (const Running_job& rj : certain_jobs) {
+					auto it = std::find_if(later.certain_jobs.begin(), later.certain_jobs.end(),
+						[&](const Running_job& l) { return earlier[l.idx] == rj.idx; });
+					if (it == later.certain_jobs.end() || !rj.parallelism.contains(it->parallelism)
+						|| !rj.finish_time.contains(shift_interval(it->finish_time)))
+						return false;
+				}
+				return true;
+			}
+
 			// first check if 'other' state can merge with this state, then, if yes, merge 'other' with this state.
 			bool try_to_merge(const Schedule_state<Time>& other, bool conservative, bool use_job_finish_times = false)
 			{
@@ -262,8 +387,7 @@ namespace NP {
 				const std::vector<Running_job>& cert_j,
 				Time ecsj_ready_time)
 			{
-				for (int i = 0; i < core_avail.size(); i++)
-					core_avail[i] |= cav[i];
+				core_avail.widen(cav);
 
 				// vector to collect joint certain jobs
 				std::vector<Running_job> new_cj;
@@ -302,8 +426,8 @@ namespace NP {
 				const Schedule_state<Time>& s)
 			{
 				stream << "Global::State(";
-				for (const auto& a : s.core_avail)
-					stream << "[" << a.from() << ", " << a.until() << "] ";
+				for (unsigned int i = 0; i < s.core_avail.size(); i++)
+					stream << "[" << s.core_avail[i].from() << ", " << s.core_avail[i].until() << "] ";
 				stream << "(";
 				for (const auto& rj : s.certain_jobs)
 					stream << rj.idx << "";
@@ -315,8 +439,8 @@ namespace NP {
 			void print_vertex_label(std::ostream& out,
 				const typename Job<Time>::Job_set& jobs) const
 			{
-				for (const auto& a : core_avail)
-					out << "[" << a.from() << ", " << a.until() << "] ";
+				for (unsigned int i = 0; i < core_avail.size(); i++)
+					out << "[" << core_avail[i].from() << ", " << core_avail[i].until() << "] ";
 				out << "\\n";
 				bool first = true;
 				out << "{";
@@ -332,6 +456,18 @@ namespace NP {
 			}
 
 		private:
+			template<typename T> static Interval<T> read_interval(Spill_reader& r)
+			{
+				T min = r.get<T>();
+				return Interval<T>(min, r.get<T>());
+			}
+
+			template<typename T> static void write_interval(Spill_writer& w, const Interval<T>& i)
+			{
+				w.put(i.min());
+				w.put(i.max());
+			}
+
 			// update the list of jobs that are certainly running in the current system state 
 			// and returns the number of predecessors of job `j` that were certainly running on cores in the previous system state
 			int update_certainly_running_jobs_and_get_num_prec(const Schedule_state& from,
@@ -387,23 +523,24 @@ namespace NP {
 				auto lst = start_times.max();
 				auto eft = finish_times.min();
 				auto lft = finish_times.max();
-				
 
-				// compute the cores availability intervals
-				Time* ca = new Time[n_cores];
-				Time* pa = new Time[n_cores];
-				unsigned int ca_idx = 0, pa_idx = 0;
-				
-				// Keep pa and ca sorted, by adding the value at the correct place.
+				// The availability intervals are built in place, without temporary arrays:
+				// the first pass appends [pa, pa] for every core (the earliest availability),
+				// the second pass replaces the upper bound of each interval by ca (the latest
+				// availability). Both pa and ca are kept sorted by adding values at the correct place.
 				bool eft_added_to_pa = false;
 				bool lft_added_to_ca = false;
+				unsigned int ca_idx = 0;
+				auto push_ca = [&](Time ca) {
+					core_avail.set(ca_idx, Interval<Time>(core_avail[ca_idx].min(), ca));
+					ca_idx++;
+				};
 
 				// note, we must skip the first ncores elements in from.core_avail
 				if (n_prec > m) {
 					// if there are n_prec predecessors running, n_prec cores must be available when j starts
 					for (int i = m; i < n_prec; i++) {
-						pa[pa_idx] = est; pa_idx++; //pa.push_back(est); // TODO: GN: check whether we can replace by est all the time since predecessors must possibly be finished by est to let j start
-						ca[ca_idx] = std::min(lst, std::max(est, from.core_avail[i].max())); ca_idx++; //ca.push_back(std::min(lst, std::max(est, from.core_avail[i].max())));
+						core_avail.emplace_back(est, est); // TODO: GN: check whether we can replace by est all the time since predecessors must possibly be finished by est to let j start
 					}
 				}
 				else {
@@ -413,41 +550,37 @@ namespace NP {
 					if (!eft_added_to_pa && eft < from.core_avail[i].min())
 					{
 						// add the finish time of j ncores times since it runs on ncores
-						for (int p = 0; p < m; p++) {
-							pa[pa_idx] = eft; pa_idx++; //pa.push_back(eft);
-						}
+						for (int p = 0; p < m; p++)
+							core_avail.emplace_back(eft, eft);
 						eft_added_to_pa = true;
 					}
-					pa[pa_idx] = std::max(est, from.core_avail[i].min()); pa_idx++; //pa.push_back(std::max(est, from.core_avail[i].min()));
-					if (!lft_added_to_ca && lft < from.core_avail[i].max()) {
-						// add the finish time of j ncores times since it runs on ncores
-						for (int p = 0; p < m; p++) {
-							ca[ca_idx] = lft; ca_idx++; //ca.push_back(lft);
-						}
-						lft_added_to_ca = true;
-					}
-					ca[ca_idx] = std::max(est, from.core_avail[i].max()); ca_idx++; //ca.push_back(std::max(est, from.core_avail[i].max()));
+					Time pa = std::max(est, from.core_avail[i].min());
+					core_avail.emplace_back(pa, pa);
 				}
 				if (!eft_added_to_pa) {
 					// add the finish time of j ncores times since it runs on ncores
-					for (int p = 0; p < m; p++) {
-						pa[pa_idx] = eft; pa_idx++; //pa.push_back(eft);
+					for (int p = 0; p < m; p++)
+						core_avail.emplace_back(eft, eft);
+				}
+
+				if (n_prec > m) {
+					for (int i = m; i < n_prec; i++)
+						push_ca(std::min(lst, std::max(est, from.core_avail[i].max())));
+				}
+				for (int i = n_prec; i < from.core_avail.size(); i++) {
+					if (!lft_added_to_ca && lft < from.core_avail[i].max()) {
+						// add the finish time of j ncores times since it runs on ncores
+						for (int p = 0; p < m; p++)
+							push_ca(lft);
+						lft_added_to_ca = true;
 					}
+					push_ca(std::max(est, from.core_avail[i].max()));
 				}
 				if (!lft_added_to_ca) {
 					// add the finish time of j ncores times since it runs on ncores
-					for (int p = 0; p < m; p++) {
-						ca[ca_idx] = lft; ca_idx++; //ca.push_back(lft);
-					}
+					for (int p = 0; p < m; p++)
+						push_ca(lft);
 				}
-
-				for (int i = 0; i < from.core_avail.size(); i++)
-				{
-					DM(i << " -> " << pa[i] << ":" << ca[i] << std::endl);
-					core_avail.emplace_back(pa[i], ca[i]);
-				}
-				delete[] pa;
-				delete[] ca;
 			}
 
 			// finds the earliest time a gang source job (i.e., a job without predecessors that requires more than one core to start executing)
@@ -621,6 +754,90 @@ namespace NP {
 			Schedule_state(const Schedule_state& origin) = delete;
 		};
 
+		// All states of one depth of the exploration are allocated from the same pool,
+		// such that their memory is released at once when the depth is retired.
+		// In parallel runs, every thread allocates from and recycles into its own slabs.
+		// Since all slabs of a depth are freed together, a thread may safely recycle
+		// a state that was allocated by another thread.
+		//
+		// The pool also holds the (immutable) sets of scheduled jobs of the nodes of
+		// the depth, which nodes may share (see derive_job_set()).
+		template<class Time> class State_pool
+		{
+			typedef Object_pool<Schedule_state<Time>> Pool;
+			typedef std::deque<Job_set> Job_sets;
+
+#ifdef CONFIG_PARALLEL
+			tbb::enumerable_thread_specific<Pool> pools;
+			tbb::enumerable_thread_specific<Job_sets> job_sets;
+
+			Pool& local()
+			{
+				return pools.local();
+			}
+
+			Job_sets& local_job_sets()
+			{
+				return job_sets.local();
+			}
+#else
+			Pool pool;
+			Job_sets job_sets;
+
+			Pool& local()
+			{
+				return pool;
+			}
+
+			Job_sets& local_job_sets()
+			{
+				return job_sets;
+			}
+#endif
+
+		public:
+
+			// a new, empty set of scheduled jobs, which is kept until the pool is
+			// destroyed or forget_job_sets() is called
+			Job_set& new_job_set()
+			{
+				return local_job_sets().emplace_back();
+			}
+
+			// the set 'from' with job j added; nodes that are derived from the same
+			// node by dispatching the same job can share the set that is returned
+			const Job_set& derive_job_set(const Job_set& from, Job_index j)
+			{
+				Job_set& jobs = new_job_set();
+				jobs.copy_from(from);
+				jobs.add(j);
+				return jobs;
+			}
+
+			// release the sets of scheduled jobs once no node refers to them anymore
+			// (not thread-safe)
+			void forget_job_sets()
+			{
+#ifdef CONFIG_PARALLEL
+				for (Job_sets& sets : job_sets)
+					sets.clear();
+#else
+				job_sets.clear();
+#endif
+			}
+
+			template <typename... Args>
+			Schedule_state<Time>* create(Args&&... args)
+			{
+				return local().create(std::forward<Args>(args)...);
+			}
+
+			void release(Schedule_state<Time>* s)
+			{
+				local().release(s);
+			}
+		};
+
 		template<class Time> class Schedule_node
 		{
 		private:
@@ -636,39 +853,63 @@ namespace NP {
 			Time next_certain_sequential_source_job_release;
 			Time next_certain_gang_source_job_disptach;
 
-			Job_set scheduled_jobs;
+			// immutable, and possibly shared with other nodes of the same depth (see State_pool)
+			const Job_set* scheduled_jobs;
 			// set of jobs that have all their predecessors completed and were not dispatched yet
 			std::vector<const Job<Time>*> ready_successor_jobs;
 			std::vector<Job_index> jobs_with_pending_succ;
 
 			hash_value_t lookup_key;
+			// second hash of scheduled_jobs, independent of lookup_key (see State_space_data::next_fingerprint())
+			hash_value_t lookup_fingerprint;
 			Interval<Time> finish_time;
 			Time a_max;
 			unsigned int num_cpus;
 			unsigned int num_jobs_scheduled;
+			// upper bound on the width of the availability interval of the first core of
+			// the states (see merge_states()); it is not reduced when states are removed
+			Time max_first_core_width;
+			// the number of times a state of this node was compared with a new state
+			unsigned long merge_attempts;
 
 			// no accidental copies
 			Schedule_node(const Schedule_node& origin) = delete;
 
-			typedef Schedule_state<Time> State;
-
-			struct eft_compare
+			// the set of scheduled jobs of all initial nodes
+			static const Job_set& no_jobs()
 			{
-				bool operator() (State* x, State* y) const
-				{
-					return x->earliest_finish_time() < y->earliest_finish_time();
-				}
-			};
+				static const Job_set empty;
+				return empty;
+			}
 
-			typedef typename std::multiset<State*, eft_compare> State_ref_queue;
+			typedef Schedule_state<Time> State;
+
+			// sorted by earliest finish time
+			typedef Sorted_states<State> State_ref_queue;
 			State_ref_queue states;
 
+			// pool the states of this node come from (nullptr if they were allocated with new)
+			State_pool<Time>* state_pool;
+
+#ifdef CONFIG_PARALLEL
 		public:
+			typedef tbb::spin_mutex Mutex;
+
+		private:
+			// held while adding or merging states, since several threads may dispatch into the same node
+			mutable Mutex mutex;
+#endif
+
+		public:
+			typedef typename State_ref_queue::const_iterator State_iterator;
+
 			Reconfiguration::Attachment *attachment;
 
 			// initial node (for convenience for unit tests)
 			Schedule_node(unsigned int num_cores, Reconfiguration::Attachment *attachment = nullptr)
-				: lookup_key{ 0 }
+				: scheduled_jobs{ &no_jobs() }
+				, lookup_key{ 0 }
+				, lookup_fingerprint{ 0 }
 				, num_cpus(num_cores)
 				, finish_time{ 0,0 }
 				, a_max{ 0 }
@@ -679,12 +920,18 @@ namespace NP {
 				, next_certain_sequential_source_job_release{ Time_model::constants<Time>::infinity() }
 				, next_certain_gang_source_job_disptach{ Time_model::constants<Time>::infinity() }
 				, attachment(attachment)
+				, state_pool(nullptr)
+				, max_first_core_width{ 0 }
+				, merge_attempts(0)
 			{
 			}
 
 			// initial node
-			Schedule_node (unsigned int num_cores, const State_space_data<Time>& state_space_data, Reconfiguration::Attachment *attachment)
-				: lookup_key{ 0 }
+			Schedule_node (unsigned int num_cores, const State_space_data<Time>& state_space_data, Reconfiguration::Attachment *attachment,
+				State_pool<Time>* state_pool = nullptr)
+				: scheduled_jobs{ &no_jobs() }
+				, lookup_key{ 0 }
+				, lookup_fingerprint{ 0 }
 				, num_cpus(num_cores)
 				, finish_time{ 0,0 }
 				, a_max{ 0 }
@@ -694,6 +941,9 @@ namespace NP {
 				, next_certain_sequential_source_job_release{ state_space_data.get_earliest_certain_seq_source_job_release() }
 				, next_certain_gang_source_job_disptach{ Time_model::constants<Time>::infinity() }
 				, attachment(attachment)
+				, state_pool(state_pool)
+				, max_first_core_width{ 0 }
+				, merge_attempts(0)
 			{
 				next_certain_source_job_release = std::min(next_certain_sequential_source_job_release, state_space_data.get_earliest_certain_gang_source_job_release());
 			}
@@ -703,14 +953,17 @@ namespace NP {
 				const Schedule_node& from,
 				const Job<Time>& j,
 				std::size_t idx,
+				const Job_set& scheduled_jobs, // the jobs of 'from' and j (see State_pool::derive_job_set())
 				const State_space_data<Time>& state_space_data,
 				const Time next_earliest_release,
 				const Time next_certain_source_job_release, // the next time a job without predecessor is certainly released
 				const Time next_certain_sequential_source_job_release, // the next time a job without predecessor that can execute on a single core is certainly released
-				Reconfiguration::Attachment *attachment
+				Reconfiguration::Attachment *attachment,
+				State_pool<Time>* state_pool = nullptr
 			)
-				: scheduled_jobs{ from.scheduled_jobs, idx }
-				, lookup_key{ from.next_key(j) }
+				: scheduled_jobs{ &scheduled_jobs }
+				, lookup_key{ state_space_data.next_key(from, j) }
+				, lookup_fingerprint{ state_space_data.next_fingerprint(from, j) }
 				, num_cpus(from.num_cpus)
 				, num_jobs_scheduled(from.num_jobs_scheduled + 1)
 				, finish_time{ 0, Time_model::constants<Time>::infinity() }
@@ -721,15 +974,88 @@ namespace NP {
 				, next_certain_sequential_source_job_release{ next_certain_sequential_source_job_release }
 				, next_certain_gang_source_job_disptach{ Time_model::constants<Time>::infinity() }
 				, attachment(attachment)
+				, state_pool(state_pool)
+				, max_first_core_width{ 0 }
+				, merge_attempts(0)
 			{
-				update_ready_successors(from, idx, state_space_data.successors_suspensions, state_space_data.predecessors_suspensions, this->scheduled_jobs);
-				update_jobs_with_pending_succ(from, idx, state_space_data.successors_suspensions, state_space_data.predecessors_suspensions, this->scheduled_jobs);
+				assert(scheduled_jobs.is_derived_from(*from.scheduled_jobs, idx));
+				update_ready_successors(from, idx, state_space_data.successors_suspensions, state_space_data.predecessors_suspensions, scheduled_jobs);
+				update_jobs_with_pending_succ(from, idx, state_space_data.successors_suspensions, state_space_data.predecessors_suspensions, scheduled_jobs);
+			}
+
+			// node read back from a spill file (see write_to()), without its states
+			Schedule_node(Spill_reader& r, const State_space_data<Time>& state_space_data, State_pool<Time>* state_pool)
+				: finish_time{ 0, Time_model::constants<Time>::infinity() }
+				, a_max{ Time_model::constants<Time>::infinity() }
+				, next_certain_successor_jobs_disptach{ Time_model::constants<Time>::infinity() }
+				, next_certain_gang_source_job_disptach{ Time_model::constants<Time>::infinity() }
+				, attachment(nullptr)
+				, state_pool(state_pool)
+				, max_first_core_width{ 0 }
+				, merge_attempts(0)
+			{
+				assert(state_pool);
+				// read in the order of write_to()
+				lookup_key = r.get<hash_value_t>();
+				lookup_fingerprint = r.get<hash_value_t>();
+				num_cpus = r.get<unsigned int>();
+				num_jobs_scheduled = r.get<unsigned int>();
+				earliest_pending_release = r.get<Time>();
+				next_certain_source_job_release = r.get<Time>();
+				next_certain_sequential_source_job_release = r.get<Time>();
+
+				Job_set& jobs = state_pool->new_job_set();
+				for (std::size_t i = 0, n = r.get<std::size_t>(); i < n; i++) {
+					uint64_t word = r.get<uint64_t>();
+					for (unsigned int b = 0; b < 64; b++)
+						if (word & (((uint64_t)1) << b))
+							jobs.add(64 * i + b);
+				}
+				scheduled_jobs = &jobs;
+
+				ready_successor_jobs.resize(r.get<std::size_t>());
+				for (auto& j : ready_successor_jobs)
+					j = &state_space_data.jobs[r.get<Job_index>()];
+
+				jobs_with_pending_succ.resize(r.get<std::size_t>());
+				for (auto& j : jobs_with_pending_succ)
+					j = r.get<Job_index>();
+			}
+
+			// Serialize the node such that it can be moved out of memory. The states
+			// are written after the node, preceded by their number. The other members
+			// of the node are not written, since add_state() derives them from the states.
+			void write_to(Spill_writer& w) const
+			{
+				w.put(lookup_key);
+				w.put(lookup_fingerprint);
+				w.put(num_cpus);
+				w.put(num_jobs_scheduled);
+				w.put(earliest_pending_release);
+				w.put(next_certain_source_job_release);
+				w.put(next_certain_sequential_source_job_release);
+
+				w.put(scheduled_jobs->words().size());
+				for (uint64_t word : scheduled_jobs->words())
+					w.put(word);
+
+				w.put(ready_successor_jobs.size());
+				for (const Job<Time>* j : ready_successor_jobs)
+					w.put(j->get_job_index());
+
+				w.put(jobs_with_pending_succ.size());
+				for (Job_index j : jobs_with_pending_succ)
+					w.put(j);
+
+				w.put(states.size());
+				for (const State* s : states)
+					s->write_to(w);
 			}
 
 			~Schedule_node()
 			{
 				for (State* s : states)
-					delete s;
+					release_state(s);
 				delete attachment;
 			}
 
@@ -777,18 +1103,18 @@ namespace NP {
 
 			const Job_set& get_scheduled_jobs() const
 			{
-				return scheduled_jobs;
+				return *scheduled_jobs;
 			}
 
 			const bool job_incomplete(Job_index j) const
 			{
-				return !scheduled_jobs.contains(j);
+				return !scheduled_jobs->contains(j);
 			}
 
 			const bool job_ready(const Job_precedence_set& predecessors) const
 			{
 				for (auto j : predecessors)
-					if (!scheduled_jobs.contains(j))
+					if (!scheduled_jobs->contains(j))
 						return false;
 				return true;
 			}
@@ -796,12 +1122,19 @@ namespace NP {
 			bool matches(const Schedule_node& other) const
 			{
 				return lookup_key == other.lookup_key &&
-					scheduled_jobs == other.scheduled_jobs;
+					*scheduled_jobs == *other.scheduled_jobs;
 			}
 
-			hash_value_t next_key(const Job<Time>& j) const
+#ifdef CONFIG_PARALLEL
+			Mutex& get_mutex() const
 			{
-				return get_key() ^ j.get_key();
+				return mutex;
+			}
+#endif
+
+			hash_value_t get_fingerprint() const
+			{
+				return lookup_fingerprint;
 			}
 
 			//  finish_range / finish_time contains information about the
@@ -824,12 +1157,14 @@ namespace NP {
 				Interval<Time> ft = s->core_availability();
 				if (states.empty()) {
 					finish_time = ft;
+					max_first_core_width = ft.until() - ft.from();
 					a_max = s->core_availability(num_cpus).max();
 					next_certain_successor_jobs_disptach = s->next_certain_successor_jobs_disptach();
 					next_certain_gang_source_job_disptach = s->next_certain_gang_source_job_disptach();
 				}
 				else {
 					finish_time.widen(ft);
+					max_first_core_width = std::max(max_first_core_width, ft.until() - ft.from());
 					a_max = std::max(a_max, s->core_availability(num_cpus).max());
 					next_certain_successor_jobs_disptach = std::max(next_certain_successor_jobs_disptach, s->next_certain_successor_jobs_disptach());
 					next_certain_gang_source_job_disptach = std::max(next_certain_gang_source_job_disptach, s->next_certain_gang_source_job_disptach());
@@ -852,14 +1187,12 @@ namespace NP {
 
 			const State* get_first_state() const
 			{
-				auto first = states.begin();
-				return *first;
+				return *states.begin();
 			}
 
 			const State* get_last_state() const
 			{
-				auto last = --(states.end());
-				return *last;
+				return *(states.end() - 1);
 			}
 
 			const State_ref_queue* get_states() const
@@ -875,65 +1208,101 @@ namespace NP {
 			// with pending successors must overlap to allow two states to merge. Setting it to true should 
 			// increase accurracy of the analysis but increases runtime significantly.
 			// The 'budget' defines how many states can be merged at once. If 'budget = -1', then there is no limit. 
-			// Returns the number of existing states the new state was merged with.
+			// Returns the number of existing states the new state was merged with (1 if it was
+			// dominated by an existing state, see Schedule_state::dominates()).
 			int merge_states(const Schedule_state<Time>& s, bool conservative, bool use_job_finish_times = false, int budget = 1)
 			{
-				// if we do not use a conservative merge, try to merge with up to 'budget' states if possible.
-				int merge_budget = conservative ? 1 : budget;
-
-				State* last_state_merged;
-				bool result = false;
-				for ( auto it = states.begin(); it != states.end();)
-				{
-					State* state = *it;
-					if (result == false)
-					{
-						if (state->try_to_merge(s, conservative, use_job_finish_times))
-						{
-							// Update the node finish_time
-							finish_time.widen(s.core_availability());
-							a_max = std::max(a_max, s.core_availability(num_cpus).max());
-							//update the certain next job ready time
-							next_certain_successor_jobs_disptach = std::max(next_certain_successor_jobs_disptach, s.next_certain_successor_jobs_disptach());
-							next_certain_gang_source_job_disptach = std::max(next_certain_gang_source_job_disptach, s.next_certain_gang_source_job_disptach());
-
-							result = true;
-
-							// Try to merge with a few more states.
-							merge_budget--;
-							if (merge_budget == 0)
-								break;
-
-							last_state_merged = state;
-						}
-						++it;
+				// Only states whose availability interval of the first core intersects the one of 's'
+				// can be merged with it. Since the states are ordered by the start of this interval and
+				// none of these intervals is wider than max_first_core_width, the candidates are a
+				// contiguous range of the states: from the first one that may still be available when
+				// 's' becomes available, up to the first one that becomes available after 's' at the latest.
+				const Time eps = Time_model::constants<Time>::epsilon();
+				const Time s_eft = s.earliest_finish_time();
+				const Time s_lft = s.core_availability().max();
+				// (the search is skipped if the first state is a candidate, which is typical of small nodes)
+				auto it = states.begin();
+				if (s_eft - eps > max_first_core_width && (*it)->earliest_finish_time() < s_eft - eps - max_first_core_width)
+					it = states.lower_bound(s_eft - eps - max_first_core_width);
+
+				// Find the first state 's' can be merged with, but drop 's' instead if it is dominated
+				// by an existing state, rather than widening a state it overlaps with. Only states
+				// that become available no later than 's' (i.e., the first ones) can dominate it.
+				// Since a dominating state could also be merged with 's', none precedes the first one.
+				auto first = states.end();
+				for (; it != states.end(); ++it) {
+					Time eft = (*it)->earliest_finish_time();
+					if (eft - eps > s_lft)
+						break;
+					merge_attempts++;
+					bool may_dominate = eft <= s_eft;
+					if (first == states.end()) {
+						if (!(*it)->can_merge_with(s, conservative, use_job_finish_times))
+							continue;
+						first = it;
 					}
-					else // if we already merged with one state at least
+					else if (!may_dominate)
+						break;
+					if (may_dominate && (*it)->dominates(s))
+						return 1;
+				}
+				if (first == states.end())
+					return 0;
+
+				State* merged = *first;
+				const Time merged_eft = merged->earliest_finish_time();
+				merged->try_to_merge(s, conservative, use_job_finish_times);
+				// Update the node finish_time
+				finish_time.widen(s.core_availability());
+				a_max = std::max(a_max, s.core_availability(num_cpus).max());
+				//update the certain next job ready time
+				next_certain_successor_jobs_disptach = std::max(next_certain_successor_jobs_disptach, s.next_certain_successor_jobs_disptach());
+				next_certain_gang_source_job_disptach = std::max(next_certain_gang_source_job_disptach, s.next_certain_gang_source_job_disptach());
+				int num_merged = 1;
+
+				// if we do not use a conservative merge, try to merge the widened state with up to
+				// 'budget' - 1 more states if possible (the next ones that can still intersect it)
+				int merge_budget = (conservative ? 1 : budget) - 1;
+				for (it = std::next(first); merge_budget != 0 && it != states.end()
+					&& (*it)->earliest_finish_time() - eps <= merged->core_availability().max();) {
+					merge_attempts++;
+					State* state = *it;
+					if (merged->try_to_merge(*state, conservative, use_job_finish_times))
 					{
-						if (last_state_merged->try_to_merge(*state, conservative, use_job_finish_times))
-						{
-							// the state was merged => we can thus remove the old one from the list of states
-							it = states.erase(it);
-							delete state;
-
-							// Try to merge with a few more states.
-							// std::cerr << "Merged with " << merge_budget << " of " << states.size() << " states left.\n";
-							merge_budget--;
-							if (merge_budget == 0)
-								break;
-						}
-						else
-							++it;
+						// the state was merged => we can thus remove the old one from the list of states
+						it = states.erase(it);
+						release_state(state);
+						merge_budget--;
+						num_merged++;
 					}
+					else
+						++it;
 				}
 
-				if (conservative)
-					return result ? 1:0;
-				else
-					return (budget - merge_budget);
+				// the widened state may become available earlier, and thus move in the order of the states
+				if (merged->earliest_finish_time() < merged_eft)
+					states.restore_order(first);
+				Interval<Time> ft = merged->core_availability();
+				max_first_core_width = std::max(max_first_core_width, ft.until() - ft.from());
+
+				return num_merged;
+			}
+
+			// the number of times a state of this node was compared with a new state (see merge_states())
+			unsigned long number_of_merge_attempts() const
+			{
+				return merge_attempts;
 			}
 
 		private:
+			void release_state(State* s)
+			{
+				if (state_pool)
+					state_pool->release(s);
+				else
+					delete s;
+			}
+
 			// update the list of jobs that have all their predecessors completed and were not dispatched yet
 			void update_ready_successors(const Schedule_node& from,
 				Job_index j, const Successors& successors_of,
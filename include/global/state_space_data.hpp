@@ -5,6 +5,7 @@
 #include <deque>
 #include <forward_list>
 #include <map>
+#include <random>
 #include <unordered_map>
 #include <vector>
 
@@ -57,6 +58,11 @@ namespace NP {
 			std::vector<Suspensions_list> _predecessors_suspensions;
 			std::vector<Suspensions_list> _successors_suspensions;
 
+			// random lookup keys and fingerprints of the jobs (empty unless
+			// use_zobrist_keys() was called)
+			std::vector<hash_value_t> zobrist_keys;
+			std::vector<hash_value_t> zobrist_fingerprints;
+
 			// list of actions when a job is aborted
 			std::vector<const Abort_action<Time>*> abort_actions;
 
@@ -115,12 +121,60 @@ namespace NP {
 					_jobs_by_deadline.insert({ j.get_deadline(), &j });
 				}
 
-				for (const Abort_action<Time>& a : aborts) {
-					const Job<Time>& j = lookup<Time>(jobs, a.get_id());
-					abort_actions[j.get_job_index()] = &a;
+				if (!aborts.empty()) {
+					const Job_id_index job_ids(jobs);
+					for (const Abort_action<Time>& a : aborts)
+						abort_actions[job_ids.index_of(a.get_id())] = &a;
+				}
+			}
+
+			// Use random Zobrist keys instead of the keys of the jobs (see Job::get_key()),
+			// which combine the parameters of a job and may thus coincide for different
+			// jobs: the key and the fingerprint of a node then form a 128-bit random
+			// signature of its set of scheduled jobs, and different sets practically never
+			// share it (see State_space::same_scheduled_jobs()). The keys are drawn with a
+			// fixed seed, such that every run (e.g., one resumed from a checkpoint) uses the
+			// same keys. Must be called before the first node is created.
+			void use_zobrist_keys()
+			{
+				std::mt19937_64 random(0x9E3779B97F4A7C15ULL);
+				zobrist_keys.resize(jobs.size());
+				zobrist_fingerprints.resize(jobs.size());
+				for (std::size_t i = 0; i < jobs.size(); i++) {
+					zobrist_keys[i] = (hash_value_t)random();
+					zobrist_fingerprints[i] = (hash_value_t)random();
 				}
 			}
 
+			bool has_zobrist_keys() const
+			{
+				return !zobrist_keys.empty();
+			}
+
+			// what j contributes to the lookup key of a node that has scheduled j;
+			// the key of a node is the XOR of those of its scheduled jobs
+			hash_value_t job_key(const Job<Time>& j) const
+			{
+				return has_zobrist_keys() ? zobrist_keys[j.get_job_index()] : j.get_key();
+			}
+
+			hash_value_t next_key(const Node& n, const Job<Time>& j) const
+			{
+				return n.get_key() ^ job_key(j);
+			}
+
+			// The fingerprint is a second hash of the scheduled jobs, independent of the
+			// lookup key. Without Zobrist keys, it adds up scrambled job keys instead of
+			// XOR-ing the plain keys, so sets of jobs whose lookup keys collide will rarely
+			// have the same fingerprint.
+			hash_value_t next_fingerprint(const Node& n, const Job<Time>& j) const
+			{
+				if (has_zobrist_keys())
+					return n.get_fingerprint() ^ zobrist_fingerprints[j.get_job_index()];
+				hash_value_t k = j.get_key();
+				return n.get_fingerprint() + (k ^ (k >> 29)) * 0xBF58476D1CE4E5B9ULL;
+			}
+
 			Time get_min_suspension(Job_index candidate, Job_index predecessor, bool signal_at_completion) const {
 				for (const Job_suspension &suspension : predecessors_suspensions[candidate]) {
 					// TODO Maybe deal with duplicate suspensions by taking the maximum
@@ -3,6 +3,8 @@
 
 #include <stdint.h>
 
+#include "index_set_kernels.hpp"
+
 namespace NP {
 
 		class Index_set
@@ -27,8 +29,13 @@ namespace NP {
 					: the_set(std::max(a.the_set.size(), b.the_set.size()), 0)
 			{
 				auto limit = std::min(a.the_set.size(), b.the_set.size());
-				for (std::size_t i = 0; i < limit; ++i)
-					the_set[i] = a.the_set[i] & ~b.the_set[i];
+				Index_set_kernels::difference(the_set.data(), a.the_set.data(), b.the_set.data(), limit);
+				std::copy(a.the_set.begin() + limit, a.the_set.end(), the_set.begin() + limit);
+			}
+
+			const Set_type& words() const
+			{
+				return the_set;
 			}
 
 			void copy_from(const Index_set &other) {
@@ -38,12 +45,40 @@ namespace NP {
 
 			bool operator==(const Index_set &other) const
 			{
-				return the_set == other.the_set;
+				return this == &other || (the_set.size() == other.the_set.size()
+					&& Index_set_kernels::equal(the_set.data(), other.the_set.data(), the_set.size()));
+			}
+
+			// true if this set is 'from' with idx added, i.e., if it is equal to
+			// Index_set(from, idx) (without building that set)
+			bool is_derived_from(const Index_set& from, std::size_t idx) const
+			{
+				if (!contains(idx))
+					return false;
+				const std::size_t w = idx / 64;
+				const uint64_t* a = the_set.data();
+				const uint64_t* f = from.the_set.data();
+				const std::size_t n = std::min(the_set.size(), from.the_set.size());
+				// the word of idx, the common words before and after it, and the words
+				// that only one of the sets has (which must be empty)
+				if (a[w] != ((w < from.the_set.size() ? f[w] : 0) | (((uint64_t)1) << (idx % 64))))
+					return false;
+				if (!Index_set_kernels::equal(a, f, std::min(w, n)))
+					return false;
+				if (w + 1 < n && !Index_set_kernels::equal(a + w + 1, f + w + 1, n - w - 1))
+					return false;
+				for (std::size_t i = n; i < the_set.size(); ++i)
+					if (i != w && a[i])
+						return false;
+				for (std::size_t i = n; i < from.the_set.size(); ++i)
+					if (f[i])
+						return false;
+				return true;
 			}
 
 			bool operator!=(const Index_set &other) const
 			{
-				return the_set != other.the_set;
+				return !(*this == other);
 			}
 
 			bool contains(std::size_t idx) const
@@ -64,24 +99,20 @@ namespace NP {
 
 			bool is_subset_of(const Index_set& other) const
 			{
-				// Compare each integer in the sets
-				for (std::size_t i = 0; i < the_set.size(); ++i) {
-					// If there are bits set in the current set that are not set in the other set, it's not a subset
-					if (the_set[i]>0 && (other.the_set.size()<=i || (the_set[i] & other.the_set[i]) != the_set[i])) {
+				std::size_t n = std::min(the_set.size(), other.the_set.size());
+				if (!Index_set_kernels::is_subset(the_set.data(), other.the_set.data(), n))
+					return false;
+				// the words that the other set does not have must be empty
+				for (std::size_t i = n; i < the_set.size(); ++i)
+					if (the_set[i])
 						return false;
-					}
-				}
-
 				return true;
 			}
 
+			// the number of indices in the set
 			std::size_t size() const
 			{
-				std::size_t count = 0;
-				for (std::size_t i = 0; i < the_set.size() * 64; ++i)
-					if (contains(i))
-						count++;
-				return count;
+				return Index_set_kernels::count(the_set.data(), the_set.size());
 			}
 
 			void add(std::size_t idx)
@@ -107,12 +138,12 @@ namespace NP {
 			{
 				bool first = true;
 				stream << "{";
-				for (std::size_t i = 0; i < s.the_set.size() * 64; ++i) {
-					if (s.contains(i)) {
+				for (std::size_t w = 0; w < s.the_set.size(); ++w) {
+					for (uint64_t bits = s.the_set[w]; bits; bits &= bits - 1) {
 						if (!first)
 							stream << ", ";
 						first = false;
-						stream << i;
+						stream << 64 * w + std::countr_zero(bits);
 					}
 				}
 				stream << "}";
@@ -1,7 +1,15 @@
 #ifndef IO_HPP
 #define IO_HPP
 
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstring>
 #include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 #include <utility>
 
 #include "interval.hpp"
@@ -9,6 +17,7 @@
 #include "jobs.hpp"
 #include "precedence.hpp"
 #include "aborts.hpp"
+#include "mapped_file.hpp"
 #include "yaml-cpp/yaml.h"
 
 namespace NP {
@@ -75,6 +84,139 @@ namespace NP {
 		skip_over(in, '\n');
 	}
 
+	// Cursor over the text of a whole CSV file (e.g., a Mapped_file). Fields
+	// are converted in place with std::from_chars() rather than extracted from
+	// an std::istream; a malformed or missing field raises an
+	// std::ios_base::failure, which nptest reports as a parse error.
+	class Csv_reader
+	{
+		const char* pos;
+		const char* end;
+		// the line of pos, for error messages
+		std::size_t line;
+
+		static bool is_blank(char c)
+		{
+			return c == ' ' || c == '\t';
+		}
+
+		static bool is_end_of_line(char c)
+		{
+			return c == '\n' || c == '\r';
+		}
+
+	public:
+
+		Csv_reader(const char* begin, const char* end)
+			: pos(begin)
+			, end(end)
+			, line(1)
+		{
+		}
+
+		// number of non-empty lines from here on, to size the parsed vectors
+		std::size_t count_rows() const
+		{
+			if (pos == end)
+				return 0;
+			std::size_t n = std::count(pos, end, '\n');
+			return end[-1] == '\n' ? n : n + 1;
+		}
+
+		// skips blank lines; false at the end of the file
+		bool more_data()
+		{
+			while (pos != end && (is_blank(*pos) || is_end_of_line(*pos))) {
+				if (*pos == '\n')
+					line++;
+				pos++;
+			}
+			return pos != end;
+		}
+
+		bool more_fields_in_line()
+		{
+			skip_blanks();
+			return pos != end && !is_end_of_line(*pos);
+		}
+
+		void skip_blanks()
+		{
+			while (pos != end && is_blank(*pos))
+				pos++;
+		}
+
+		// skips c (and the blanks before it) if it is next
+		bool skip_one(char c)
+		{
+			skip_blanks();
+			if (pos != end && *pos == c) {
+				pos++;
+				return true;
+			}
+			return false;
+		}
+
+		// skips the blanks and delimiters up to the next field
+		void next_field(char field_delimiter = ',')
+		{
+			while (pos != end && (is_blank(*pos) || *pos == field_delimiter))
+				pos++;
+		}
+
+		// skips the rest of the line, including any extra columns
+		void next_line()
+		{
+			if (pos == end)
+				return;
+			auto nl = static_cast<const char*>(std::memchr(pos, '\n', end - pos));
+			pos = nl ? nl + 1 : end;
+			line++;
+		}
+
+		template<typename T> T get()
+		{
+			skip_blanks();
+			if (pos != end && *pos == '+')
+				pos++;
+			T value;
+			auto [next, ec] = std::from_chars(pos, end, value);
+			if (ec != std::errc())
+				fail();
+			pos = next;
+			return value;
+		}
+
+		// the text up to the next blank, delimiter or end of line
+		std::string_view word(char field_delimiter = ',')
+		{
+			skip_blanks();
+			const char* from = pos;
+			while (pos != end && !is_blank(*pos) && !is_end_of_line(*pos) && *pos != field_delimiter)
+				pos++;
+			return std::string_view(from, pos - from);
+		}
+
+		[[noreturn]] void fail() const
+		{
+			throw std::ios_base::failure("line " + std::to_string(line) + ": unexpected or missing field");
+		}
+	};
+
+	// the whole (remaining) contents of a stream, for the Csv_reader
+	inline std::string read_all(std::istream& in)
+	{
+		return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+	}
+
+	// the current line of a stream, for the Csv_reader
+	inline std::string read_line(std::istream& in)
+	{
+		std::string row;
+		std::getline(in, row);
+		return row;
+	}
+
 	inline JobID parse_job_id(std::istream& in)
 	{
 		unsigned long jid, tid;
@@ -118,43 +260,39 @@ namespace NP {
 
 	//Functions that help parse selfsuspending tasks file
 	template<class Time>
-	Precedence_constraint<Time> parse_precedence_constraint(std::istream &in)
+	Precedence_constraint<Time> parse_precedence_constraint(Csv_reader& in)
 	{
 		unsigned long from_tid, from_jid, to_tid, to_jid;
 		Time sus_min=0, sus_max=0;
-		std::string signal_type;
 		bool signal_at_completion = true;
 
-		std::ios_base::iostate state_before = in.exceptions();
-
-		in.exceptions(std::istream::failbit | std::istream::badbit);
-
-		in >> from_tid;
-		next_field(in);
-		in >> from_jid;
-		next_field(in);
-		in >> to_tid;
-		next_field(in);
-		in >> to_jid;
-		next_field(in);
-		if (more_fields_in_line(in))
+		from_tid = in.get<unsigned long>();
+		in.next_field();
+		from_jid = in.get<unsigned long>();
+		in.next_field();
+		to_tid = in.get<unsigned long>();
+		in.next_field();
+		to_jid = in.get<unsigned long>();
+		in.next_field();
+		if (in.more_fields_in_line())
 		{
-			in >> sus_min;
-			next_field(in);
-			in >> sus_max;
+			sus_min = in.get<Time>();
+			in.next_field();
+			sus_max = in.get<Time>();
 		}
 
-		next_field(in);
-		if (more_fields_in_line(in))
+		in.next_field();
+		if (in.more_fields_in_line())
 		{
-			in >> signal_type;
-			std::transform(signal_type.begin(), signal_type.end(), signal_type.begin(), [](unsigned char c){ return std::tolower(c); });
-			if (signal_type == "start") signal_at_completion = false;
-			else if (signal_type != "completion") throw std::invalid_argument("Unexpecteds Signal At: must be 'start' or 'completion'");
+			std::string_view signal_type = in.word();
+			auto is = [&](std::string_view expected) {
+				return std::equal(signal_type.begin(), signal_type.end(), expected.begin(), expected.end(),
+				                  [](char a, char b) { return std::tolower((unsigned char) a) == b; });
+			};
+			if (is("start")) signal_at_completion = false;
+			else if (!is("completion")) throw std::invalid_argument("Unexpecteds Signal At: must be 'start' or 'completion'");
 		}
 
-		in.exceptions(state_before);
-
 		return Precedence_constraint<Time>{JobID{from_jid, from_tid},
 											JobID{to_jid, to_tid},
 											Interval<Time>{sus_min, sus_max},
@@ -162,21 +300,44 @@ namespace NP {
 	}
 
 	template<class Time>
-	std::vector<Precedence_constraint<Time>> parse_precedence_file(std::istream& in)
+	Precedence_constraint<Time> parse_precedence_constraint(std::istream &in)
+	{
+		std::string row = read_line(in);
+		Csv_reader r(row.data(), row.data() + row.size());
+		return parse_precedence_constraint<Time>(r);
+	}
+
+	template<class Time>
+	std::vector<Precedence_constraint<Time>> parse_precedence_file(const char* begin, const char* end)
 	{
+		Csv_reader in(begin, end);
 		// skip column headers
-		next_line(in);
+		in.next_line();
 		std::vector<Precedence_constraint<Time>> cstr;
+		cstr.reserve(in.count_rows());
 
 		// parse all rows
-		while (more_data(in)) {
+		while (in.more_data()) {
 			// each row contains one self-suspending constraint
 			cstr.push_back(parse_precedence_constraint<Time>(in));
-			next_line(in);
+			in.next_line();
 		}
 		return cstr;
 	}
 
+	template<class Time>
+	std::vector<Precedence_constraint<Time>> parse_precedence_file(const Mapped_file& file)
+	{
+		return parse_precedence_file<Time>(file.begin(), file.end());
+	}
+
+	template<class Time>
+	std::vector<Precedence_constraint<Time>> parse_precedence_file(std::istream& in)
+	{
+		std::string text = read_all(in);
+		return parse_precedence_file<Time>(text.data(), text.data() + text.size());
+	}
+
 	template<class Time>
 	inline std::vector<Precedence_constraint<Time>> parse_yaml_dag_file(std::istream& in)
 	{
@@ -222,57 +383,93 @@ namespace NP {
 		return edges;
 	}
 
-	template<class Time> 
-	Job<Time> parse_job(std::istream& in, std::size_t idx)
+	template<class Time>
+	Job<Time> parse_job(Csv_reader& in, std::size_t idx)
 	{
 		unsigned long tid, jid;
-
-		std::ios_base::iostate state_before = in.exceptions();
-
-		Time arr_min, arr_max, dl, prio;
-		std::map<unsigned int, Interval<Time>> cost;
-
-		in.exceptions(std::istream::failbit | std::istream::badbit);
-
-		in >> tid;
-		next_field(in);
-		in >> jid;
-		next_field(in);
-		in >> arr_min;
-		next_field(in);
-		in >> arr_max;
-		next_field(in);
-		parse_job_cost(in, cost);
-		next_field(in);
-		in >> dl;
-		next_field(in);
-		in >> prio;
-
-		in.exceptions(state_before);
+		Time arr_min, arr_max, cost_min, cost_max, dl, prio;
+
+		tid = in.get<unsigned long>();
+		in.next_field();
+		jid = in.get<unsigned long>();
+		in.next_field();
+		arr_min = in.get<Time>();
+		in.next_field();
+		arr_max = in.get<Time>();
+		in.next_field();
+		if (in.skip_one('{')) { // expected format: { paral:cost_min:cost_max; paral:cost_min:cost_max; ... }
+			typename Job<Time>::Cost cost;
+			while (!in.skip_one('}')) {
+				unsigned int paral = in.get<unsigned int>();
+				in.next_field(':');
+				cost_min = in.get<Time>();
+				in.next_field(':');
+				cost_max = in.get<Time>();
+				cost.emplace(paral, Interval<Time>{cost_min, cost_max});
+				in.skip_one(';');
+			}
+			if (cost.empty())
+				in.fail();
+			in.next_field();
+			dl = in.get<Time>();
+			in.next_field();
+			prio = in.get<Time>();
+
+			return Job<Time> {jid, Interval<Time>{arr_min, arr_max},
+							cost, dl, prio, idx, tid};
+		}
+		cost_min = in.get<Time>();
+		in.next_field();
+		cost_max = in.get<Time>();
+		in.next_field();
+		dl = in.get<Time>();
+		in.next_field();
+		prio = in.get<Time>();
 
 		return Job<Time> {jid, Interval<Time>{arr_min, arr_max},
-						cost, dl, prio, idx, tid};
+						Interval<Time>{cost_min, cost_max}, dl, prio, idx, tid};
+	}
+
+	template<class Time> 
+	Job<Time> parse_job(std::istream& in, std::size_t idx)
+	{
+		std::string row = read_line(in);
+		Csv_reader r(row.data(), row.data() + row.size());
+		return parse_job<Time>(r, idx);
 	}
 
 	template<class Time>
-	typename Job<Time>::Job_set parse_csv_job_file(std::istream& in)
+	typename Job<Time>::Job_set parse_csv_job_file(const char* begin, const char* end)
 	{
+		Csv_reader in(begin, end);
 		// first row contains a comment, just skip it
-		next_line(in);
+		in.next_line();
 
 		typename Job<Time>::Job_set jobs;
-		std::size_t idx=0;
+		jobs.reserve(in.count_rows());
 
-		while (more_data(in)) {
-			jobs.push_back(parse_job<Time>(in, idx));
-			idx++;
+		while (in.more_data()) {
+			jobs.push_back(parse_job<Time>(in, jobs.size()));
 			// munge any trailing whitespace or extra columns
-			next_line(in);
+			in.next_line();
 		}
 
 		return jobs;
 	}
 
+	template<class Time>
+	typename Job<Time>::Job_set parse_csv_job_file(const Mapped_file& file)
+	{
+		return parse_csv_job_file<Time>(file.begin(), file.end());
+	}
+
+	template<class Time>
+	typename Job<Time>::Job_set parse_csv_job_file(std::istream& in)
+	{
+		std::string text = read_all(in);
+		return parse_csv_job_file<Time>(text.data(), text.data() + text.size());
+	}
+
 	//Functions that help parse the abort actions file
 	template<class Time>
 	typename Job<Time>::Job_set parse_yaml_job_file(std::istream& in)
@@ -305,52 +502,67 @@ namespace NP {
 	}
 
 	template<class Time>
-	Abort_action<Time> parse_abort_action(std::istream& in)
+	Abort_action<Time> parse_abort_action(Csv_reader& in)
 	{
 		unsigned long tid, jid;
 		Time trig_min, trig_max, cleanup_min, cleanup_max;
 
-		std::ios_base::iostate state_before = in.exceptions();
-
-		in.exceptions(std::istream::failbit | std::istream::badbit);
-
-		in >> tid;
-		next_field(in);
-		in >> jid;
-		next_field(in);
-		in >> trig_min;
-		next_field(in);
-		in >> trig_max;
-		next_field(in);
-		in >> cleanup_min;
-		next_field(in);
-		in >> cleanup_max;
-
-		in.exceptions(state_before);
+		tid = in.get<unsigned long>();
+		in.next_field();
+		jid = in.get<unsigned long>();
+		in.next_field();
+		trig_min = in.get<Time>();
+		in.next_field();
+		trig_max = in.get<Time>();
+		in.next_field();
+		cleanup_min = in.get<Time>();
+		in.next_field();
+		cleanup_max = in.get<Time>();
 
 		return Abort_action<Time>{JobID{jid, tid},
 		                          Interval<Time>{trig_min, trig_max},
 		                          Interval<Time>{cleanup_min, cleanup_max}};
 	}
 
+	template<class Time>
+	Abort_action<Time> parse_abort_action(std::istream& in)
+	{
+		std::string row = read_line(in);
+		Csv_reader r(row.data(), row.data() + row.size());
+		return parse_abort_action<Time>(r);
+	}
 
 	template<class Time>
-	std::vector<Abort_action<Time>> parse_abort_file(std::istream& in)
+	std::vector<Abort_action<Time>> parse_abort_file(const char* begin, const char* end)
 	{
+		Csv_reader in(begin, end);
 		// first row contains a comment, just skip it
-		next_line(in);
+		in.next_line();
 
 		std::vector<Abort_action<Time>> abort_actions;
+		abort_actions.reserve(in.count_rows());
 
-		while (more_data(in)) {
+		while (in.more_data()) {
 			abort_actions.push_back(parse_abort_action<Time>(in));
 			// munge any trailing whitespace or extra columns
-			next_line(in);
+			in.next_line();
 		}
 
 		return abort_actions;
 	}
 
+	template<class Time>
+	std::vector<Abort_action<Time>> parse_abort_file(const Mapped_file& file)
+	{
+		return parse_abort_file<Time>(file.begin(), file.end());
+	}
+
+	template<class Time>
+	std::vector<Abort_action<Time>> parse_abort_file(std::istream& in)
+	{
+		std::string text = read_all(in);
+		return parse_abort_file<Time>(text.data(), text.data() + text.size());
+	}
 
 }
 
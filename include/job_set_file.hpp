@@ -0,0 +1,309 @@
+#ifndef JOB_SET_FILE_HPP
+#define JOB_SET_FILE_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "jobs.hpp"
+#include "precedence.hpp"
+#include "aborts.hpp"
+#include "mapped_file.hpp"
+
+namespace NP {
+
+	// Binary job set files (*.npjobs), which hold a workload (jobs, precedence
+	// constraints with suspensions, abort actions) that has already been parsed,
+	// such that repeated analyses of the same job set do not parse text again.
+	//
+	// Layout: the magic string, the format version, the time model (see
+	// time_model()), the number of jobs n, of costs m, of precedence constraints e
+	// and of abort actions a, followed by the columns
+	//
+	//   task IDs, job IDs, earliest and latest arrivals, deadlines, priorities (n each),
+	//   offsets of the costs of each job (n + 1), levels of parallelism (m),
+	//   least and largest costs (m each),
+	//   offsets of the successors of each job (n + 1), successor job indices (e),
+	//   least and largest suspensions (e each), whether to signal at completion (e),
+	//   job indices of the abort actions (a), earliest and latest trigger times
+	//   and least and largest cleanup costs (a each).
+	//
+	// The precedence constraints are grouped by predecessor (compressed sparse
+	// rows). Each column starts at a multiple of eight bytes, such that a
+	// mapped file can be read in place. All values are stored in the native
+	// byte order, as in checkpoints.
+	namespace Job_set_file {
+
+		static const char magic[8] = { 'N', 'P', 'J', 'O', 'B', 'S', '\r', '\n' };
+		static const std::uint32_t version = 1;
+
+		// the file extension that nptest recognizes
+		static const std::string extension = ".npjobs";
+
+		// the time model the columns of times were written with
+		template<class Time> std::uint32_t time_model()
+		{
+			static_assert(sizeof(Time) == 8, "times are stored in 64 bits");
+			return std::is_floating_point<Time>::value ? 1 : 0;
+		}
+
+		struct Header {
+			char magic[8];
+			std::uint32_t version;
+			std::uint32_t time_model;
+			std::uint64_t num_jobs, num_costs, num_edges, num_aborts;
+		};
+
+		// the number of bytes of a column of n values of type T, including the padding
+		template<typename T> std::size_t column_size(std::uint64_t n)
+		{
+			return (n * sizeof(T) + 7) / 8 * 8;
+		}
+
+		template<class Time>
+		void write(const std::string& path,
+		           const typename Job<Time>::Job_set& jobs,
+		           const std::vector<Precedence_constraint<Time>>& prec,
+		           const std::vector<Abort_action<Time>>& aborts)
+		{
+			const Job_id_index job_ids(jobs);
+
+			std::vector<std::uint64_t> task_ids, job_ids_column, cost_offsets{0};
+			std::vector<Time> arrival_min, arrival_max, deadlines, priorities, cost_min, cost_max;
+			std::vector<std::uint32_t> parallelism;
+			for (const Job<Time>& j : jobs) {
+				task_ids.push_back(j.get_task_id());
+				job_ids_column.push_back(j.get_job_id());
+				arrival_min.push_back(j.earliest_arrival());
+				arrival_max.push_back(j.latest_arrival());
+				deadlines.push_back(j.get_deadline());
+				priorities.push_back(j.get_priority());
+				for (const auto& c : j.get_all_costs()) {
+					parallelism.push_back(c.first);
+					cost_min.push_back(c.second.min());
+					cost_max.push_back(c.second.max());
+				}
+				cost_offsets.push_back(parallelism.size());
+			}
+
+			// group the constraints by predecessor, keeping their order otherwise
+			std::vector<std::uint64_t> edge_offsets(jobs.size() + 1, 0), edge_to(prec.size());
+			std::vector<Time> sus_min(prec.size()), sus_max(prec.size());
+			std::vector<std::uint8_t> signal_at_completion(prec.size());
+			for (const auto& p : prec)
+				edge_offsets[job_ids.index_of(p.get_fromID()) + 1]++;
+			for (std::size_t i = 0; i < jobs.size(); i++)
+				edge_offsets[i + 1] += edge_offsets[i];
+			std::vector<std::uint64_t> next(edge_offsets.begin(), edge_offsets.end() - 1);
+			for (const auto& p : prec) {
+				std::uint64_t k = next[job_ids.index_of(p.get_fromID())]++;
+				edge_to[k] = job_ids.index_of(p.get_toID());
+				sus_min[k] = p.get_minsus();
+				sus_max[k] = p.get_maxsus();
+				signal_at_completion[k] = p.should_signal_at_completion();
+			}
+
+			std::vector<std::uint64_t> abort_jobs;
+			std::vector<Time> trigger_min, trigger_max, cleanup_min, cleanup_max;
+			for (const auto& a : aborts) {
+				abort_jobs.push_back(job_ids.index_of(a.get_id()));
+				trigger_min.push_back(a.earliest_trigger_time());
+				trigger_max.push_back(a.latest_trigger_time());
+				cleanup_min.push_back(a.least_cleanup_cost());
+				cleanup_max.push_back(a.maximum_cleanup_cost());
+			}
+
+			std::FILE* file = std::fopen(path.c_str(), "wb");
+			if (!file)
+				throw std::runtime_error("could not create " + path);
+			bool ok = true;
+			auto put = [&](const void* data, std::size_t size) {
+				ok = ok && std::fwrite(data, 1, size, file) == size;
+			};
+			auto put_column = [&](const auto& column) {
+				using T = typename std::decay_t<decltype(column)>::value_type;
+				static const char padding[8] = {};
+				put(column.data(), column.size() * sizeof(T));
+				put(padding, column_size<T>(column.size()) - column.size() * sizeof(T));
+			};
+
+			Header h;
+			std::memcpy(h.magic, magic, sizeof(magic));
+			h.version = version;
+			h.time_model = time_model<Time>();
+			h.num_jobs = jobs.size();
+			h.num_costs = parallelism.size();
+			h.num_edges = prec.size();
+			h.num_aborts = aborts.size();
+			put(&h, sizeof(h));
+
+			put_column(task_ids);
+			put_column(job_ids_column);
+			put_column(arrival_min);
+			put_column(arrival_max);
+			put_column(deadlines);
+			put_column(priorities);
+			put_column(cost_offsets);
+			put_column(parallelism);
+			put_column(cost_min);
+			put_column(cost_max);
+			put_column(edge_offsets);
+			put_column(edge_to);
+			put_column(sus_min);
+			put_column(sus_max);
+			put_column(signal_at_completion);
+			put_column(abort_jobs);
+			put_column(trigger_min);
+			put_column(trigger_max);
+			put_column(cleanup_min);
+			put_column(cleanup_max);
+
+			if (std::fclose(file) != 0 || !ok)
+				throw std::runtime_error("could not write " + path);
+		}
+
+		// Maps a binary job set file and reads the workload straight from the
+		// columns of the mapping: the only work per job is constructing it.
+		template<class Time>
+		class Reader
+		{
+			Mapped_file file;
+			std::string path;
+			Header header;
+
+			const std::uint64_t *task_ids, *job_ids, *cost_offsets, *edge_offsets, *edge_to, *abort_jobs;
+			const std::uint32_t* parallelism;
+			const std::uint8_t* signal_at_completion;
+			const Time *arrival_min, *arrival_max, *deadlines, *priorities, *cost_min, *cost_max,
+				*sus_min, *sus_max, *trigger_min, *trigger_max, *cleanup_min, *cleanup_max;
+
+			[[noreturn]] void corrupt() const
+			{
+				throw std::runtime_error(path + " is not a valid binary job set");
+			}
+
+		public:
+
+			explicit Reader(const std::string& path)
+				: file(path)
+				, path(path)
+			{
+				if (!file.exists())
+					throw std::runtime_error("could not read " + path);
+				if (file.size() < sizeof(Header))
+					corrupt();
+				std::memcpy(&header, file.begin(), sizeof(Header));
+				if (std::memcmp(header.magic, magic, sizeof(magic)) != 0)
+					corrupt();
+				if (header.version != version)
+					throw std::runtime_error(path + " was written by another version of nptest");
+				if (header.time_model != time_model<Time>())
+					throw std::runtime_error(path + " was written for "
+						+ (header.time_model ? "dense" : "discrete") + " time (see --time)");
+
+				const std::uint64_t n = header.num_jobs, m = header.num_costs,
+					e = header.num_edges, a = header.num_aborts;
+				// check the size before looking at the columns, the counts may be garbage
+				if (n > file.size() || m > file.size() || e > file.size() || a > file.size())
+					corrupt();
+
+				const char* pos = file.begin() + sizeof(Header);
+				auto column = [&](auto*& values, std::uint64_t count) {
+					using T = std::remove_const_t<std::remove_reference_t<decltype(*values)>>;
+					values = reinterpret_cast<const T*>(pos);
+					pos += column_size<T>(count);
+				};
+				column(task_ids, n);
+				column(job_ids, n);
+				column(arrival_min, n);
+				column(arrival_max, n);
+				column(deadlines, n);
+				column(priorities, n);
+				column(cost_offsets, n + 1);
+				column(parallelism, m);
+				column(cost_min, m);
+				column(cost_max, m);
+				column(edge_offsets, n + 1);
+				column(edge_to, e);
+				column(sus_min, e);
+				column(sus_max, e);
+				column(signal_at_completion, e);
+				column(abort_jobs, a);
+				column(trigger_min, a);
+				column(trigger_max, a);
+				column(cleanup_min, a);
+				column(cleanup_max, a);
+				if (pos != file.end())
+					corrupt();
+				if (cost_offsets[0] != 0 || cost_offsets[n] != m || edge_offsets[0] != 0 || edge_offsets[n] != e)
+					corrupt();
+			}
+
+			std::size_t number_of_jobs() const
+			{
+				return header.num_jobs;
+			}
+
+			typename Job<Time>::Job_set jobs() const
+			{
+				typename Job<Time>::Job_set jobs;
+				jobs.reserve(header.num_jobs);
+				for (std::size_t i = 0; i < header.num_jobs; i++) {
+					const std::uint64_t from = cost_offsets[i], to = cost_offsets[i + 1];
+					if (from >= to || to > header.num_costs)
+						corrupt();
+					Interval<Time> arrival{arrival_min[i], arrival_max[i]};
+					if (to - from == 1 && parallelism[from] == 1)
+						jobs.push_back(Job<Time>{job_ids[i], arrival, Interval<Time>{cost_min[from], cost_max[from]},
+						                         deadlines[i], priorities[i], i, task_ids[i]});
+					else {
+						typename Job<Time>::Cost cost;
+						for (std::uint64_t k = from; k < to; k++)
+							cost.emplace(parallelism[k], Interval<Time>{cost_min[k], cost_max[k]});
+						jobs.push_back(Job<Time>{job_ids[i], arrival, cost, deadlines[i], priorities[i], i, task_ids[i]});
+					}
+				}
+				return jobs;
+			}
+
+			std::vector<Precedence_constraint<Time>> precedence_constraints() const
+			{
+				std::vector<Precedence_constraint<Time>> prec;
+				prec.reserve(header.num_edges);
+				for (std::size_t i = 0; i < header.num_jobs; i++) {
+					const std::uint64_t from = edge_offsets[i], to = edge_offsets[i + 1];
+					if (from > to || to > header.num_edges)
+						corrupt();
+					for (std::uint64_t k = from; k < to; k++) {
+						if (edge_to[k] >= header.num_jobs)
+							corrupt();
+						prec.push_back(Precedence_constraint<Time>{JobID{job_ids[i], task_ids[i]},
+							JobID{job_ids[edge_to[k]], task_ids[edge_to[k]]},
+							Interval<Time>{sus_min[k], sus_max[k]}, signal_at_completion[k] != 0});
+					}
+				}
+				return prec;
+			}
+
+			std::vector<Abort_action<Time>> abort_actions() const
+			{
+				std::vector<Abort_action<Time>> aborts;
+				aborts.reserve(header.num_aborts);
+				for (std::size_t k = 0; k < header.num_aborts; k++) {
+					if (abort_jobs[k] >= header.num_jobs)
+						corrupt();
+					aborts.push_back(Abort_action<Time>{JobID{job_ids[abort_jobs[k]], task_ids[abort_jobs[k]]},
+						Interval<Time>{trigger_min[k], trigger_max[k]},
+						Interval<Time>{cleanup_min[k], cleanup_max[k]}});
+				}
+				return aborts;
+			}
+		};
+	}
+}
+
+#endif
@@ -7,6 +7,7 @@
 #include <algorithm> // for find
 #include <functional> // for hash
 #include <exception>
+#include <unordered_map>
 
 #include "time.hpp"
 #include "interval.hpp"
@@ -329,4 +330,50 @@ namespace std {
 	};
 }
 
+namespace NP {
+
+	// Index of the jobs of a workload by their JobID, such that references to jobs
+	// (in precedence constraints, abort actions, ...) are resolved in constant time
+	// instead of by a linear search (see lookup()). It stores positions in the
+	// workload, so it stays valid as long as jobs are not added, removed or reordered.
+	class Job_id_index
+	{
+		std::unordered_map<JobID, Job_index> positions;
+
+	public:
+
+		Job_id_index()
+		{
+		}
+
+		template<class Time> explicit Job_id_index(const std::vector<Job<Time>>& jobs)
+		{
+			positions.reserve(jobs.size());
+			// as lookup(), find the first of several jobs with the same id
+			for (Job_index i = 0; i < jobs.size(); i++)
+				positions.emplace(jobs[i].get_id(), i);
+		}
+
+		// the position in the workload of the job with the given id
+		Job_index index_of(const JobID& id) const
+		{
+			auto pos = positions.find(id);
+			if (pos == positions.end())
+				throw InvalidJobReference(id);
+			return pos->second;
+		}
+
+		template<class Time>
+		const Job<Time>& lookup(const std::vector<Job<Time>>& jobs, const JobID& id) const
+		{
+			return jobs[index_of(id)];
+		}
+
+		bool contains(const JobID& id) const
+		{
+			return positions.count(id) > 0;
+		}
+	};
+}
+
 #endif
@@ -0,0 +1,108 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace NP {
+
+	// Read-only view of a whole file. Where possible, the file is mapped
+	// into memory instead of being read, such that large inputs (job sets,
+	// checkpoints) are not copied before they are parsed.
+	class Mapped_file
+	{
+		const char* bytes;
+		std::size_t length;
+#ifdef _WIN32
+		std::vector<char> buffer;
+#endif
+
+		// no accidental copies
+		Mapped_file(const Mapped_file& origin) = delete;
+
+	public:
+
+		// maps the file at path, or nothing if it does not exist
+		explicit Mapped_file(const std::string& path)
+			: bytes(nullptr)
+			, length(0)
+		{
+#ifdef _WIN32
+			std::FILE* f = std::fopen(path.c_str(), "rb");
+			if (!f)
+				return;
+			std::fseek(f, 0, SEEK_END);
+			buffer.resize(std::ftell(f));
+			std::rewind(f);
+			bool ok = std::fread(buffer.data(), 1, buffer.size(), f) == buffer.size();
+			std::fclose(f);
+			if (!ok)
+				throw std::runtime_error("could not read " + path);
+			length = buffer.size();
+			bytes = length ? buffer.data() : "";
+#else
+			int fd = open(path.c_str(), O_RDONLY);
+			if (fd < 0)
+				return;
+			struct stat st;
+			if (fstat(fd, &st) != 0) {
+				close(fd);
+				throw std::runtime_error("could not read " + path);
+			}
+			if (st.st_size == 0) {
+				// an empty file cannot be mapped
+				close(fd);
+				bytes = "";
+				return;
+			}
+			void* mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			close(fd);
+			if (mapped == MAP_FAILED)
+				throw std::runtime_error("could not map " + path);
+			// the file is read front to back
+			madvise(mapped, st.st_size, MADV_SEQUENTIAL);
+			bytes = static_cast<const char*>(mapped);
+			length = st.st_size;
+#endif
+		}
+
+		~Mapped_file()
+		{
+#ifndef _WIN32
+			if (length)
+				munmap(const_cast<char*>(bytes), length);
+#endif
+		}
+
+		bool exists() const
+		{
+			return bytes != nullptr;
+		}
+
+		const char* begin() const
+		{
+			return bytes;
+		}
+
+		const char* end() const
+		{
+			return bytes + length;
+		}
+
+		std::size_t size() const
+		{
+			return length;
+		}
+	};
+}
+
+#endif
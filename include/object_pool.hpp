@@ -0,0 +1,105 @@
+#ifndef OBJECT_POOL_HPP
+#define OBJECT_POOL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace NP {
+
+	// Slab allocator for objects of type T.
+	// Objects are carved out of slabs that grow geometrically, released
+	// objects are recycled through a free list, and all slabs are returned
+	// at once when the pool is destroyed. The pool does not keep track of
+	// live objects: their owners must release (or at least destroy) them
+	// before the pool goes away.
+	template<class T> class Object_pool
+	{
+		union Slot {
+			Slot* next_free;
+			alignas(T) unsigned char storage[sizeof(T)];
+		};
+
+		// small first slab so that narrow depths do not pay for a large one
+		static constexpr std::size_t first_slab_size = 16;
+		static constexpr std::size_t max_slab_size = 1024;
+
+		std::vector<std::unique_ptr<Slot[]>> slabs;
+		Slot* free_list;
+		// number of slots of the last slab that were already handed out
+		std::size_t slab_used;
+		std::size_t slab_size;
+		std::size_t num_allocations;
+
+		// no accidental copies
+		Object_pool(const Object_pool& origin) = delete;
+
+		Slot* allocate_slot()
+		{
+			num_allocations++;
+			if (free_list != nullptr) {
+				Slot* slot = free_list;
+				free_list = slot->next_free;
+				return slot;
+			}
+			if (slab_used == slab_size) {
+				slab_size = slabs.empty() ? first_slab_size : std::min(2 * slab_size, max_slab_size);
+				slabs.emplace_back(new Slot[slab_size]);
+				slab_used = 0;
+			}
+			return &slabs.back()[slab_used++];
+		}
+
+		void recycle_slot(Slot* slot)
+		{
+			slot->next_free = free_list;
+			free_list = slot;
+		}
+
+	public:
+
+		Object_pool()
+			: free_list(nullptr)
+			, slab_used(0)
+			, slab_size(0)
+			, num_allocations(0)
+		{
+		}
+
+		template <typename... Args>
+		T* create(Args&&... args)
+		{
+			Slot* slot = allocate_slot();
+			try {
+				return new (slot->storage) T(std::forward<Args>(args)...);
+			} catch (...) {
+				recycle_slot(slot);
+				throw;
+			}
+		}
+
+		// destroy obj and make its slot available for the next create()
+		void release(T* obj)
+		{
+			obj->~T();
+			recycle_slot(reinterpret_cast<Slot*>(obj));
+		}
+
+		// number of objects created by this pool
+		std::size_t number_of_allocations() const
+		{
+			return num_allocations;
+		}
+
+		// number of slabs requested from the general-purpose allocator
+		std::size_t number_of_slabs() const
+		{
+			return slabs.size();
+		}
+	};
+}
+
+#endif
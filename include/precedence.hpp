@@ -98,21 +98,28 @@ namespace NP {
 
 	template<class Time>
 	void validate_prec_cstrnts(std::vector<Precedence_constraint<Time>>& precs,
-		const typename Job<Time>::Job_set jobs)
+		const Job_id_index& job_ids)
 	{
 
 		for (Precedence_constraint<Time>& prec : precs) {
-			const Job<Time>& fromJob = lookup<Time>(jobs, prec.get_fromID());
-			const Job<Time>& toJob = lookup<Time>(jobs, prec.get_toID());
+			Job_index from = job_ids.index_of(prec.get_fromID());
+			Job_index to = job_ids.index_of(prec.get_toID());
 			// set toIndex and fromIndex here.
 			// TODO: get rid of this. Dangerous that job index is changed after construction !
-			prec.set_toIndex((Job_index)(&toJob - &(jobs[0])));
-			prec.set_fromIndex((Job_index)(&fromJob - &(jobs[0])));
+			prec.set_toIndex(to);
+			prec.set_fromIndex(from);
 			if (prec.get_maxsus() < prec.get_minsus()) {
 				throw InvalidPrecParameter(prec.get_fromID());
 			}
 		}
 	}
+
+	template<class Time>
+	void validate_prec_cstrnts(std::vector<Precedence_constraint<Time>>& precs,
+		const typename Job<Time>::Job_set& jobs)
+	{
+		validate_prec_cstrnts<Time>(precs, Job_id_index(jobs));
+	}
 }
 
 #endif
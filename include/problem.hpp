@@ -1,6 +1,8 @@
 #ifndef NP_PROBLEM_HPP
 #define NP_PROBLEM_HPP
 
+#include <string>
+
 #include "jobs.hpp"
 #include "precedence.hpp"
 #include "aborts.hpp"
@@ -23,6 +25,10 @@ namespace NP {
 		// (3) abort actions for (some of) the jobs
 		Abort_actions aborts;
 
+		// the positions of the jobs by JobID, such that job references are
+		// resolved in constant time (jobs must not change after construction)
+		Job_id_index job_ids;
+
 		// ** Platform model:
 		// on how many (identical) processors are the jobs being
 		// dispatched (globally, in priority order)
@@ -34,9 +40,10 @@ namespace NP {
 		: num_processors(num_processors)
 		, jobs(jobs)
 		, prec(prec)
+		, job_ids(this->jobs)
 		{
 			assert(num_processors > 0);
-			validate_prec_cstrnts<Time>(this->prec, jobs);
+			validate_prec_cstrnts<Time>(this->prec, job_ids);
 		}
 
 		// Constructor with abort actions and precedence constraints
@@ -47,10 +54,11 @@ namespace NP {
 		, jobs(jobs)
 		, prec(prec)
 		, aborts(aborts)
+		, job_ids(this->jobs)
 		{
 			assert(num_processors > 0);
-			validate_prec_cstrnts<Time>(this->prec, jobs);
-			validate_abort_refs<Time>(aborts, jobs);
+			validate_prec_cstrnts<Time>(this->prec, job_ids);
+			validate_abort_refs<Time>(aborts, this->jobs, job_ids);
 		}
 
 		// Convenience constructor: no DAG, no abort actions
@@ -58,6 +66,7 @@ namespace NP {
 		                   unsigned int num_processors = 1)
 		: jobs(jobs)
 		, num_processors(num_processors)
+		, job_ids(this->jobs)
 		{
 			assert(num_processors > 0);
 		}
@@ -88,6 +97,55 @@ namespace NP {
 		bool merge_use_job_finish_times;
 		int merge_depth;
 
+		// Should the nodes of the next depth be built by sorting all
+		// transitions of a depth by their set of scheduled jobs, instead
+		// of looking up each new set in a hash table? (global analysis
+		// only, ignored when a reconfiguration agent is used)
+		bool sort_frontier;
+
+		// Should the nodes be identified by random 128-bit (Zobrist) keys of
+		// their sets of scheduled jobs, which are trusted when looking up the
+		// node of a new set, instead of keys derived from the job parameters,
+		// which need a comparison of the sets? (global analysis only; debug
+		// builds still compare the sets)
+		bool zobrist_keys;
+
+		// Should the schedule graph be recorded, such that it can be
+		// printed once the analysis is over? (global analysis only)
+		bool collect_schedule_graph;
+
+		// Upper bound (in bytes) on the memory used by the nodes of the next
+		// depth; beyond it, they are moved to files in spill_dir (or in the
+		// default temporary directory if empty). 0 means no bound.
+		// (global analysis only, ignored by the naive exploration, with a
+		// reconfiguration agent, and when the schedule graph is collected)
+		std::size_t memory_limit;
+		std::string spill_dir;
+
+		// If not empty, a checkpoint of the exploration is written to this file
+		// at the start of a depth, at most every checkpoint_interval seconds of
+		// CPU time, and removed once the analysis is complete. If resume is set
+		// and the file exists, the analysis continues from the checkpoint.
+		// (global analysis only, ignored by the naive exploration, with a
+		// reconfiguration agent, and when the schedule graph is collected)
+		std::string checkpoint_file;
+		double checkpoint_interval;
+		bool resume;
+
+		// Should the jobs be split at points where all cores are certainly idle,
+		// such that the resulting segments can be analysed separately?
+		// (global analysis only, ignored with a reconfiguration agent, a depth
+		// limit, checkpoints, and when the schedule graph is collected)
+		bool decompose;
+
+		// If positive, the hyperperiod of the periodic tasks of which the jobs
+		// are unrolled: the exploration stops once it repeats itself one
+		// hyperperiod later, and the response times of the remaining jobs are
+		// derived from those of their counterparts. (global analysis only,
+		// ignored with a reconfiguration agent and when the schedule graph is
+		// collected)
+		double hyperperiod;
+
 		// Should we write where we are in the analysis?
 		bool verbose;
 
@@ -99,6 +157,14 @@ namespace NP {
 		, merge_conservative(false)
 		, merge_use_job_finish_times(false)
 		, merge_depth(1)
+		, sort_frontier(false)
+		, zobrist_keys(false)
+		, collect_schedule_graph(false)
+		, memory_limit(0)
+		, checkpoint_interval(0)
+		, resume(false)
+		, decompose(false)
+		, hyperperiod(0)
 		, verbose(false)
 		{
 		}
@@ -41,7 +41,7 @@ namespace NP::Reconfiguration {
 				Interval<Time>(), false
 			));
 		}
-		validate_prec_cstrnts<Time>(problem.prec, problem.jobs);
+		validate_prec_cstrnts<Time>(problem.prec, problem.job_ids);
 	}
 }
 
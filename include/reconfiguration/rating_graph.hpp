@@ -3,6 +3,11 @@
 #include <ranges>
 #include <vector>
 #include <array>
+#include <atomic>
+
+#ifdef CONFIG_PARALLEL
+#include "tbb/concurrent_vector.h"
+#endif
 
 #include "agent.hpp"
 #include "attachment.hpp"
@@ -66,31 +71,55 @@ namespace NP::Reconfiguration {
 	};
 
 	struct Rating_node {
-		uint8_t raw_rating = 0;
+		// atomic because worker threads of a parallel exploration may mark
+		// a node as failed while others read its rating
+		std::atomic<uint8_t> raw_rating = 0;
+
+		Rating_node() = default;
+
+		Rating_node(const Rating_node &other) : raw_rating(other.raw_rating.load(std::memory_order_relaxed)) {}
+
+		Rating_node& operator=(const Rating_node &other) {
+			raw_rating.store(other.raw_rating.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			return *this;
+		}
 
 		double get_rating() const {
-			if (raw_rating == 255) return -1.0;
-			return static_cast<double>(raw_rating) / 250.0;
+			const uint8_t raw = raw_rating.load(std::memory_order_relaxed);
+			if (raw == 255) return -1.0;
+			return static_cast<double>(raw) / 250.0;
 		}
 
 		void set_rating(double rating) {
 			if (rating == -1.0) {
-				raw_rating = 255;
+				raw_rating.store(255, std::memory_order_relaxed);
 				return;
 			}
 			assert(rating >= 0.0 && rating <= 1.001);
-			raw_rating = static_cast<uint8_t>(250.0 * rating + 0.5);
-			if (rating > 0.0 && raw_rating == 0) raw_rating = 1;
-			if (rating < 1.0 && raw_rating == 250) raw_rating = 249;
+			uint8_t raw = static_cast<uint8_t>(250.0 * rating + 0.5);
+			if (rating > 0.0 && raw == 0) raw = 1;
+			if (rating < 1.0 && raw == 250) raw = 249;
+			raw_rating.store(raw, std::memory_order_relaxed);
 		}
 	};
 
+	/**
+	 * In multi-threaded analyses, add_node() and insert_edge() may be called concurrently
+	 * by the worker threads. The nodes of a depth are still numbered after those of the
+	 * previous depth, and every child after its parent, since the explorer creates all
+	 * nodes of depth d + 1 while exploring depth d.
+	 */
 	class Rating_graph {
 		bool dry_run = true;
-		size_t edge_counter = 0;
+		std::atomic<size_t> edge_counter = 0;
 	public:
+#ifdef CONFIG_PARALLEL
+		tbb::concurrent_vector<Rating_node> nodes;
+		tbb::concurrent_vector<Rating_edge> edges;
+#else
 		std::vector<Rating_node> nodes;
 		std::vector<Rating_edge> edges;
+#endif
 		double timeout = 0.0;
 
 		Rating_graph() {
@@ -160,8 +189,12 @@ namespace NP::Reconfiguration {
 			assert(taken_job >= 0);
 			if (nodes[parent_index].get_rating() == -1.0 && false) return parent_index;
 
+#ifdef CONFIG_PARALLEL
+			size_t child_index = nodes.push_back(Rating_node { }) - nodes.begin();
+#else
 			size_t child_index = nodes.size();
 			nodes.push_back(Rating_node { });
+#endif
 			if (nodes[parent_index].get_rating() == -1.0) nodes[child_index].set_rating(-1.0); // TODO Do this cleaner
 			if (dry_run) edge_counter += 1;
 			else edges.push_back(Rating_edge(parent_index, child_index, taken_job));
@@ -11,7 +11,7 @@ namespace NP::Reconfiguration {
 			problem.prec[constraint_index] = problem.prec[problem.prec.size() - 1];
 			problem.prec.pop_back();
 		}
-		validate_prec_cstrnts<Time>(problem.prec, problem.jobs);
+		validate_prec_cstrnts<Time>(problem.prec, problem.job_ids);
 	}
 }
 
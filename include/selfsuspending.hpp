@@ -96,16 +96,14 @@ namespace NP {
 
 	template<class Time>
 	void validate_susp_refs(std::vector<Suspending_Task<Time>>& susps,
-							const typename Job<Time>::Job_set jobs)
+							const typename Job<Time>::Job_set& jobs)
 	{
-	
+	  const Job_id_index job_ids(jobs);
 	  for (int idx=0; idx<susps.size(); idx++) {
-			const Job<Time>& fromJob = lookup<Time>(jobs, susps[idx].get_fromID());
-			const Job<Time>& toJob = lookup<Time>(jobs, susps[idx].get_toID());
 			// RV: after validation, susps should not be changed.
 			//     set toIndex and fromIndex here.
-			susps[idx].set_toIndex((Job_index)(&toJob - &(jobs[0])));
-			susps[idx].set_fromIndex((Job_index)(&fromJob - &(jobs[0])));
+			susps[idx].set_toIndex(job_ids.index_of(susps[idx].get_toID()));
+			susps[idx].set_fromIndex(job_ids.index_of(susps[idx].get_fromID()));
 			if (susps[idx].get_maxsus() < susps[idx].get_minsus()) {
 				throw Invalid_Self_Suspending_Parameter(susps[idx].get_fromID());
 			}
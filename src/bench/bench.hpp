@@ -0,0 +1,43 @@
+#ifndef BENCH_HPP
+#define BENCH_HPP
+
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace NP::Bench {
+
+	// number of calls to the global operator new (see main.cpp)
+	extern std::atomic<unsigned long long> num_allocations;
+
+	struct Measurement {
+		double seconds;
+		unsigned long long allocations;
+	};
+
+	// run f once and record its wall-clock time and number of heap allocations
+	template<class F> Measurement measure(F f)
+	{
+		const auto allocations_before = num_allocations.load();
+		const auto start = std::chrono::steady_clock::now();
+		f();
+		const auto stop = std::chrono::steady_clock::now();
+		std::chrono::duration<double> spent = stop - start;
+		return Measurement{ spent.count(), num_allocations.load() - allocations_before };
+	}
+
+	// print one row of results: label, time and allocations per operation
+	inline void report(const std::string& label, const Measurement& m, unsigned long long num_ops)
+	{
+		std::cout << std::left << std::setw(48) << label << std::right
+		          << std::fixed << std::setprecision(1)
+		          << std::setw(12) << (m.seconds * 1e9 / num_ops) << " ns/op"
+		          << std::setprecision(3)
+		          << std::setw(10) << ((double) m.allocations / num_ops) << " allocs/op"
+		          << std::endl;
+	}
+}
+
+#endif
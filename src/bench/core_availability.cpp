@@ -0,0 +1,116 @@
+#include "doctest.h"
+
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "interval.hpp"
+#include "global/availability_intervals.hpp"
+
+using namespace NP;
+
+typedef std::vector<Interval<dtime_t>> Interval_array;
+typedef Global::Availability_intervals<dtime_t> Split_bounds;
+
+static const unsigned int num_pairs = 1000;
+static const unsigned int num_rounds = 200;
+
+// the pair-by-pair loops that Schedule_state used before the min/max arrays
+static bool aos_contains(const Interval_array& a, const Interval_array& b)
+{
+	for (unsigned int i = 0; i < a.size(); i++)
+		if (!a[i].contains(b[i]))
+			return false;
+	return true;
+}
+
+static bool aos_intersects(const Interval_array& a, const Interval_array& b)
+{
+	for (unsigned int i = 0; i < a.size(); i++)
+		if (!a[i].intersects(b[i]))
+			return false;
+	return true;
+}
+
+static void aos_widen(Interval_array& a, const Interval_array& b)
+{
+	for (unsigned int i = 0; i < a.size(); i++)
+		a[i] |= b[i];
+}
+
+// compare the layouts on pairs of core availabilities where (almost) every core
+// needs to be compared, as in the successful merges of Schedule_node::merge_states
+static void bench_layouts(unsigned int num_cpus)
+{
+	std::vector<Interval_array> aos_a(num_pairs), aos_b(num_pairs);
+	std::vector<Split_bounds> soa_a(num_pairs), soa_b(num_pairs);
+	for (unsigned int p = 0; p < num_pairs; p++) {
+		soa_a[p].reserve(num_cpus);
+		soa_b[p].reserve(num_cpus);
+		for (unsigned int i = 0; i < num_cpus; i++) {
+			dtime_t t = 10 * i + p % 5;
+			aos_a[p].emplace_back(t, t + 8);
+			soa_a[p].emplace_back(t, t + 8);
+			aos_b[p].emplace_back(t + 1, t + 6);
+			soa_b[p].emplace_back(t + 1, t + 6);
+		}
+	}
+
+	const unsigned long long num_ops = (unsigned long long) num_pairs * num_rounds;
+	unsigned long long hits = 0;
+	const std::string m = " (m = " + std::to_string(num_cpus) + ")";
+
+	auto aos_cont = Bench::measure([&]() {
+		for (unsigned int r = 0; r < num_rounds; r++)
+			for (unsigned int p = 0; p < num_pairs; p++)
+				hits += aos_contains(aos_a[p], aos_b[p]) + aos_contains(aos_b[p], aos_a[p]);
+	});
+	auto soa_cont = Bench::measure([&]() {
+		for (unsigned int r = 0; r < num_rounds; r++)
+			for (unsigned int p = 0; p < num_pairs; p++)
+				hits += soa_a[p].contains(soa_b[p]) + soa_b[p].contains(soa_a[p]);
+	});
+	auto aos_inter = Bench::measure([&]() {
+		for (unsigned int r = 0; r < num_rounds; r++)
+			for (unsigned int p = 0; p < num_pairs; p++)
+				hits += aos_intersects(aos_a[p], aos_b[p]);
+	});
+	auto soa_inter = Bench::measure([&]() {
+		for (unsigned int r = 0; r < num_rounds; r++)
+			for (unsigned int p = 0; p < num_pairs; p++)
+				hits += soa_a[p].intersects(soa_b[p]);
+	});
+	auto aos_wid = Bench::measure([&]() {
+		for (unsigned int r = 0; r < num_rounds; r++)
+			for (unsigned int p = 0; p < num_pairs; p++)
+				aos_widen(aos_a[p], aos_b[p]);
+	});
+	auto soa_wid = Bench::measure([&]() {
+		for (unsigned int r = 0; r < num_rounds; r++)
+			for (unsigned int p = 0; p < num_pairs; p++)
+				soa_a[p].widen(soa_b[p]);
+	});
+
+	// both layouts must agree
+	CHECK(hits == 4 * num_ops);
+	for (unsigned int p = 0; p < num_pairs; p++)
+		for (unsigned int i = 0; i < num_cpus; i++)
+			CHECK(aos_a[p][i] == soa_a[p][i]);
+
+	Bench::report("  contains, intervals" + m, aos_cont, num_ops);
+	Bench::report("  contains, min/max arrays" + m, soa_cont, num_ops);
+	Bench::report("  intersects, intervals" + m, aos_inter, num_ops);
+	Bench::report("  intersects, min/max arrays" + m, soa_inter, num_ops);
+	Bench::report("  widen, intervals" + m, aos_wid, num_ops);
+	Bench::report("  widen, min/max arrays" + m, soa_wid, num_ops);
+}
+
+TEST_CASE("[bench] Core availability layout") {
+#ifdef __AVX2__
+	std::cout << std::endl << "Core availability layout (AVX2 kernels)" << std::endl;
+#else
+	std::cout << std::endl << "Core availability layout (scalar kernels)" << std::endl;
+#endif
+	for (unsigned int num_cpus : { 4, 8, 16, 32 })
+		bench_layouts(num_cpus);
+}
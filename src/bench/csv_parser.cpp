@@ -0,0 +1,104 @@
+#include "doctest.h"
+
+#include <fstream>
+#include <string>
+
+#include "bench.hpp"
+#include "io.hpp"
+
+using namespace NP;
+
+// the large job set with precedence constraints in comparison/ (37k jobs, 36k edges)
+static const std::string comparison_dir = std::string(__FILE__).substr(0, std::string(__FILE__).rfind("src/bench/")) + "comparison/";
+
+// how parse_csv_job_file and parse_precedence_file read a file before the
+// Csv_reader: field by field with operator>>, with exceptions enabled per row
+template<class Time>
+static typename Job<Time>::Job_set stream_parse_jobs(std::istream& in)
+{
+	next_line(in);
+	typename Job<Time>::Job_set jobs;
+	while (more_data(in)) {
+		unsigned long tid, jid;
+		Time arr_min, arr_max, dl, prio;
+		std::map<unsigned int, Interval<Time>> cost;
+		std::ios_base::iostate state_before = in.exceptions();
+		in.exceptions(std::istream::failbit | std::istream::badbit);
+		in >> tid;
+		next_field(in);
+		in >> jid;
+		next_field(in);
+		in >> arr_min;
+		next_field(in);
+		in >> arr_max;
+		next_field(in);
+		parse_job_cost(in, cost);
+		next_field(in);
+		in >> dl;
+		next_field(in);
+		in >> prio;
+		in.exceptions(state_before);
+		jobs.push_back(Job<Time>{jid, Interval<Time>{arr_min, arr_max}, cost, dl, prio, jobs.size(), tid});
+		next_line(in);
+	}
+	return jobs;
+}
+
+template<class Time>
+static std::vector<Precedence_constraint<Time>> stream_parse_precedence(std::istream& in)
+{
+	next_line(in);
+	std::vector<Precedence_constraint<Time>> cstr;
+	while (more_data(in)) {
+		unsigned long from_tid, from_jid, to_tid, to_jid;
+		std::ios_base::iostate state_before = in.exceptions();
+		in.exceptions(std::istream::failbit | std::istream::badbit);
+		in >> from_tid;
+		next_field(in);
+		in >> from_jid;
+		next_field(in);
+		in >> to_tid;
+		next_field(in);
+		in >> to_jid;
+		in.exceptions(state_before);
+		cstr.push_back(Precedence_constraint<Time>{JobID{from_jid, from_tid}, JobID{to_jid, to_tid}, Interval<Time>{0, 0}});
+		next_line(in);
+	}
+	return cstr;
+}
+
+TEST_CASE("[bench] CSV job and precedence parser") {
+	const std::string jobs_file = comparison_dir + "jobset-pe2.csv";
+	const std::string prec_file = comparison_dir + "jobset-pe2.prec.csv";
+	if (!std::ifstream(jobs_file) || !std::ifstream(prec_file)) {
+		std::cout << std::endl << "CSV parser: " << jobs_file << " not found, skipped" << std::endl;
+		return;
+	}
+
+	Job<dtime_t>::Job_set old_jobs, jobs;
+	std::vector<Precedence_constraint<dtime_t>> old_prec, prec;
+	auto stream = Bench::measure([&]() {
+		std::ifstream jobs_in(jobs_file), prec_in(prec_file);
+		old_jobs = stream_parse_jobs<dtime_t>(jobs_in);
+		old_prec = stream_parse_precedence<dtime_t>(prec_in);
+	});
+	auto mapped = Bench::measure([&]() {
+		jobs = parse_csv_job_file<dtime_t>(Mapped_file(jobs_file));
+		prec = parse_precedence_file<dtime_t>(Mapped_file(prec_file));
+	});
+
+	// both parsers must read the same workload
+	REQUIRE(jobs.size() == old_jobs.size());
+	REQUIRE(prec.size() == old_prec.size());
+	for (std::size_t i = 0; i < jobs.size(); i++)
+		CHECK(jobs[i].get_key() == old_jobs[i].get_key());
+	for (std::size_t i = 0; i < prec.size(); i++) {
+		CHECK(prec[i].get_fromID() == old_prec[i].get_fromID());
+		CHECK(prec[i].get_toID() == old_prec[i].get_toID());
+	}
+
+	std::cout << std::endl << "CSV parser (jobset-pe2: " << jobs.size() << " jobs, "
+		<< prec.size() << " precedence constraints)" << std::endl;
+	Bench::report("  istream, operator>> (per line)", stream, jobs.size() + prec.size());
+	Bench::report("  Mapped_file, Csv_reader (per line)", mapped, jobs.size() + prec.size());
+}
@@ -0,0 +1,57 @@
+#include "doctest.h"
+
+#include <string>
+
+#ifdef CONFIG_PARALLEL
+#include "tbb/task_arena.h"
+#endif
+
+#include "bench.hpp"
+#include "global/space.hpp"
+
+using namespace NP;
+
+typedef Global::State_space<dtime_t> Space;
+
+// groups of jobs with overlapping release windows, such that every depth has many nodes
+static Scheduling_problem<dtime_t> wide_problem(unsigned int num_cpus)
+{
+	Scheduling_problem<dtime_t>::Workload jobs;
+	for (unsigned int i = 0; i < 48; i++) {
+		dtime_t release = 20 * (i / 6);
+		jobs.push_back(Job<dtime_t>{i + 1, Interval<dtime_t>(release, release + 40),
+			Interval<dtime_t>(3, 9 + i % 5), 10000, i % 7, i, i});
+	}
+	return Scheduling_problem<dtime_t>{jobs, num_cpus};
+}
+
+static void bench_frontier(const Scheduling_problem<dtime_t>& prob, bool sort_frontier, const std::string& label)
+{
+	Analysis_options opts;
+	opts.sort_frontier = sort_frontier;
+	Space* space = nullptr;
+	auto m = Bench::measure([&]() {
+		space = Space::explore(prob, opts);
+	});
+	CHECK(space->is_schedulable());
+	Bench::report(label + ", " + std::to_string(space->number_of_nodes()) + " nodes", m, space->number_of_edges());
+	delete space;
+}
+
+TEST_CASE("[bench] Frontier construction") {
+	std::cout << std::endl << "Frontier construction (per edge)" << std::endl;
+	auto prob = wide_problem(4);
+#ifdef CONFIG_PARALLEL
+	for (unsigned int num_threads : { 1, 2, 4, 8, 16 }) {
+		tbb::task_arena arena(num_threads);
+		const std::string threads = ", " + std::to_string(num_threads) + " threads";
+		arena.execute([&]() {
+			bench_frontier(prob, false, "  hash table" + threads);
+			bench_frontier(prob, true, "  sorting" + threads);
+		});
+	}
+#else
+	bench_frontier(prob, false, "  hash table");
+	bench_frontier(prob, true, "  sorting");
+#endif
+}
@@ -0,0 +1,105 @@
+#include "doctest.h"
+
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "index_set.hpp"
+
+using namespace NP;
+
+static const unsigned int num_sets = 200;
+static const unsigned int num_rounds = 50;
+
+// the loops that Index_set used before the word-wise kernels
+static std::size_t bitwise_size(const Index_set& s)
+{
+	std::size_t count = 0;
+	for (std::size_t i = 0; i < s.words().size() * 64; ++i)
+		if (s.contains(i))
+			count++;
+	return count;
+}
+
+static bool wordwise_is_subset_of(const Index_set& a, const Index_set& b)
+{
+	const auto& x = a.words();
+	const auto& y = b.words();
+	for (std::size_t i = 0; i < x.size(); ++i)
+		if (x[i] > 0 && (y.size() <= i || (x[i] & y[i]) != x[i]))
+			return false;
+	return true;
+}
+
+// sets of scheduled jobs of num_jobs jobs, where most of the first jobs are scheduled,
+// as in the nodes of the middle depths of an exploration
+static void bench_sets(std::size_t num_jobs)
+{
+	std::vector<Index_set> sets(num_sets), copies(num_sets), supersets(num_sets);
+	for (unsigned int k = 0; k < num_sets; k++) {
+		for (std::size_t i = 0; i < num_jobs / 2; i++)
+			if ((i + k) % 17)
+				sets[k].add(i);
+		sets[k].add(num_jobs - 1);
+		copies[k].copy_from(sets[k]);
+		supersets[k].copy_from(sets[k]);
+		supersets[k].add(k % (num_jobs / 2));
+	}
+
+	const unsigned long long num_ops = (unsigned long long) num_sets * num_rounds;
+	unsigned long long bitwise_count = 0, count = 0, subsets = 0, equal = 0;
+	const std::string n = " (" + std::to_string(num_jobs) + " jobs)";
+
+	auto old_size = Bench::measure([&]() {
+		for (unsigned int r = 0; r < num_rounds; r++)
+			for (const Index_set& s : sets)
+				bitwise_count += bitwise_size(s);
+	});
+	auto new_size = Bench::measure([&]() {
+		for (unsigned int r = 0; r < num_rounds; r++)
+			for (const Index_set& s : sets)
+				count += s.size();
+	});
+	auto old_subset = Bench::measure([&]() {
+		for (unsigned int r = 0; r < num_rounds; r++)
+			for (unsigned int k = 0; k < num_sets; k++)
+				subsets += wordwise_is_subset_of(sets[k], supersets[k]);
+	});
+	auto new_subset = Bench::measure([&]() {
+		for (unsigned int r = 0; r < num_rounds; r++)
+			for (unsigned int k = 0; k < num_sets; k++)
+				subsets += sets[k].is_subset_of(supersets[k]);
+	});
+	auto old_equal = Bench::measure([&]() {
+		for (unsigned int r = 0; r < num_rounds; r++)
+			for (unsigned int k = 0; k < num_sets; k++)
+				equal += sets[k].words() == copies[k].words();
+	});
+	auto new_equal = Bench::measure([&]() {
+		for (unsigned int r = 0; r < num_rounds; r++)
+			for (unsigned int k = 0; k < num_sets; k++)
+				equal += sets[k] == copies[k];
+	});
+
+	// both versions must agree (equal sets are compared word by word up to the end)
+	CHECK(count == bitwise_count);
+	CHECK(subsets == 2 * num_ops);
+	CHECK(equal == 2 * num_ops);
+
+	Bench::report("  size, bit by bit" + n, old_size, num_ops);
+	Bench::report("  size, popcount" + n, new_size, num_ops);
+	Bench::report("  is_subset_of, word loop" + n, old_subset, num_ops);
+	Bench::report("  is_subset_of, kernel" + n, new_subset, num_ops);
+	Bench::report("  equality, vector comparison" + n, old_equal, num_ops);
+	Bench::report("  equality, Index_set" + n, new_equal, num_ops);
+}
+
+TEST_CASE("[bench] Index_set operations") {
+#ifdef __AVX2__
+	std::cout << std::endl << "Index_set operations (AVX2 kernels)" << std::endl;
+#else
+	std::cout << std::endl << "Index_set operations (scalar kernels)" << std::endl;
+#endif
+	for (std::size_t num_jobs : { 64, 1000, 5000 })
+		bench_sets(num_jobs);
+}
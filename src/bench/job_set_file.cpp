@@ -0,0 +1,52 @@
+#include "doctest.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "bench.hpp"
+#include "io.hpp"
+#include "job_set_file.hpp"
+
+using namespace NP;
+
+// the large job set with precedence constraints in comparison/ (37k jobs, 36k edges)
+static const std::string comparison_dir = std::string(__FILE__).substr(0, std::string(__FILE__).rfind("src/bench/")) + "comparison/";
+
+TEST_CASE("[bench] Binary job set loading") {
+	const std::string jobs_file = comparison_dir + "jobset-pe2.csv";
+	const std::string prec_file = comparison_dir + "jobset-pe2.prec.csv";
+	const std::string binary_file = "bench_jobset-pe2.npjobs";
+	if (!std::ifstream(jobs_file) || !std::ifstream(prec_file)) {
+		std::cout << std::endl << "Binary job set: " << jobs_file << " not found, skipped" << std::endl;
+		return;
+	}
+
+	Job<dtime_t>::Job_set csv_jobs, jobs;
+	std::vector<Precedence_constraint<dtime_t>> csv_prec, prec;
+	auto csv = Bench::measure([&]() {
+		csv_jobs = parse_csv_job_file<dtime_t>(Mapped_file(jobs_file));
+		csv_prec = parse_precedence_file<dtime_t>(Mapped_file(prec_file));
+	});
+	auto convert = Bench::measure([&]() {
+		Job_set_file::write<dtime_t>(binary_file, csv_jobs, csv_prec, {});
+	});
+	auto binary = Bench::measure([&]() {
+		Job_set_file::Reader<dtime_t> file(binary_file);
+		jobs = file.jobs();
+		prec = file.precedence_constraints();
+	});
+	std::remove(binary_file.c_str());
+
+	// the same workload, with the constraints grouped by predecessor
+	REQUIRE(jobs.size() == csv_jobs.size());
+	REQUIRE(prec.size() == csv_prec.size());
+	for (std::size_t i = 0; i < jobs.size(); i++)
+		CHECK(jobs[i].get_key() == csv_jobs[i].get_key());
+
+	std::cout << std::endl << "Binary job set (jobset-pe2: " << jobs.size() << " jobs, "
+		<< prec.size() << " precedence constraints)" << std::endl;
+	Bench::report("  parse CSV files (per job)", csv, jobs.size());
+	Bench::report("  write binary job set (per job)", convert, jobs.size());
+	Bench::report("  load binary job set (per job)", binary, jobs.size());
+}
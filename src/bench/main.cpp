@@ -0,0 +1,28 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <cstdlib>
+#include <new>
+
+#include "bench.hpp"
+
+// Count heap allocations such that benchmarks can report allocations per operation.
+std::atomic<unsigned long long> NP::Bench::num_allocations{ 0 };
+
+void* operator new(std::size_t size)
+{
+	NP::Bench::num_allocations++;
+	if (void* p = std::malloc(size ? size : 1))
+		return p;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+	std::free(p);
+}
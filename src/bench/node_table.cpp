@@ -0,0 +1,106 @@
+#ifdef CONFIG_PARALLEL
+#include "doctest.h"
+
+#include <deque>
+#include <forward_list>
+#include <string>
+
+#include "tbb/concurrent_hash_map.h"
+#include "tbb/enumerable_thread_specific.h"
+#include "tbb/parallel_for.h"
+#include "tbb/task_arena.h"
+
+#include "bench.hpp"
+#include "global/node_table.hpp"
+
+using namespace NP;
+
+struct Bench_node {
+	hash_value_t id;
+};
+
+static const unsigned long num_dispatches = 1000000;
+// few distinct successor nodes, such that many threads dispatch into the same ones
+static const unsigned long num_distinct_nodes = 2000;
+
+// the id of the node reached by the i-th dispatch; the raw ids are used as keys
+// such that neighbouring dispatches collide in both tables
+static hash_value_t node_id(unsigned long i)
+{
+	return (i * 7919) % num_distinct_nodes;
+}
+
+// the pattern the parallel explorer used before: a write accessor on the key is held
+// while the list of nodes with that key is searched and extended
+static Bench::Measurement bench_concurrent_hash_map(unsigned int num_threads, unsigned long& num_created)
+{
+	typedef tbb::concurrent_hash_map<hash_value_t, std::forward_list<Bench_node*>> Map;
+	Map map;
+	tbb::enumerable_thread_specific<std::deque<Bench_node>> nodes;
+	tbb::task_arena arena(num_threads);
+
+	auto m = Bench::measure([&]() {
+		arena.execute([&]() {
+			tbb::parallel_for(tbb::blocked_range<unsigned long>(0, num_dispatches),
+				[&](const tbb::blocked_range<unsigned long>& r) {
+					for (unsigned long i = r.begin(); i != r.end(); i++) {
+						hash_value_t id = node_id(i);
+						Map::accessor acc;
+						map.insert(acc, id);
+						Bench_node* next = nullptr;
+						for (Bench_node* other : acc->second)
+							if (other->id == id)
+								next = other;
+						if (next == nullptr)
+							acc->second.push_front(&nodes.local().emplace_back(Bench_node{ id }));
+					}
+				});
+		});
+	});
+	num_created = 0;
+	for (const auto& local_nodes : nodes)
+		num_created += local_nodes.size();
+	return m;
+}
+
+static Bench::Measurement bench_concurrent_node_table(unsigned int num_threads, unsigned long& num_created)
+{
+	Global::Concurrent_node_table<Bench_node> table;
+	tbb::enumerable_thread_specific<std::deque<Bench_node>> nodes;
+	tbb::task_arena arena(num_threads);
+
+	auto m = Bench::measure([&]() {
+		arena.execute([&]() {
+			tbb::parallel_for(tbb::blocked_range<unsigned long>(0, num_dispatches),
+				[&](const tbb::blocked_range<unsigned long>& r) {
+					for (unsigned long i = r.begin(); i != r.end(); i++) {
+						hash_value_t id = node_id(i);
+						table.find_or_insert(id, id,
+							[&](Bench_node* other) { return other->id == id; },
+							[&]() { return &nodes.local().emplace_back(Bench_node{ id }); },
+							[&](Bench_node*) { nodes.local().pop_back(); });
+					}
+				});
+		});
+	});
+	num_created = 0;
+	for (const auto& local_nodes : nodes)
+		num_created += local_nodes.size();
+	return m;
+}
+
+TEST_CASE("[bench] Parallel node deduplication") {
+	std::cout << std::endl << "Parallel node deduplication (per dispatch, "
+	          << num_distinct_nodes << " distinct nodes)" << std::endl;
+	for (unsigned int num_threads : { 1, 2, 4, 8, 16, 32, 64 }) {
+		unsigned long created_map, created_table;
+		auto map = bench_concurrent_hash_map(num_threads, created_map);
+		auto table = bench_concurrent_node_table(num_threads, created_table);
+		// both must create every node exactly once
+		CHECK(created_map == num_distinct_nodes);
+		CHECK(created_table == num_distinct_nodes);
+		Bench::report("  concurrent_hash_map, " + std::to_string(num_threads) + " threads", map, num_dispatches);
+		Bench::report("  Concurrent_node_table, " + std::to_string(num_threads) + " threads", table, num_dispatches);
+	}
+}
+#endif
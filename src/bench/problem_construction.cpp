@@ -0,0 +1,65 @@
+#include "doctest.h"
+
+#include <fstream>
+#include <optional>
+#include <string>
+
+#include "bench.hpp"
+#include "io.hpp"
+#include "problem.hpp"
+
+using namespace NP;
+
+// the job set with many precedence constraints in comparison/ (37k jobs, 36k edges)
+static const std::string comparison_dir = std::string(__FILE__).substr(0, std::string(__FILE__).rfind("src/bench/")) + "comparison/";
+
+// what validate_prec_cstrnts did before the JobID index: a copy of the
+// workload and a linear search per job reference
+template<class Time>
+static void linear_validate(std::vector<Precedence_constraint<Time>>& precs, const typename Job<Time>::Job_set jobs)
+{
+	for (Precedence_constraint<Time>& prec : precs) {
+		const Job<Time>& from = lookup<Time>(jobs, prec.get_fromID());
+		const Job<Time>& to = lookup<Time>(jobs, prec.get_toID());
+		prec.set_toIndex((Job_index)(&to - &jobs[0]));
+		prec.set_fromIndex((Job_index)(&from - &jobs[0]));
+	}
+}
+
+TEST_CASE("[bench] Problem construction with precedence constraints") {
+	std::ifstream jobs_in(comparison_dir + "jobset-pe2.csv");
+	std::ifstream prec_in(comparison_dir + "jobset-pe2.prec.csv");
+	if (!jobs_in || !prec_in) {
+		std::cout << std::endl << "Problem construction: " << comparison_dir << "jobset-pe2.csv not found, skipped" << std::endl;
+		return;
+	}
+	Scheduling_problem<dtime_t>::Workload jobs;
+	Scheduling_problem<dtime_t>::Precedence_constraints prec;
+	auto parse = Bench::measure([&]() {
+		jobs = parse_csv_job_file<dtime_t>(jobs_in);
+		prec = parse_precedence_file<dtime_t>(prec_in);
+	});
+
+	Scheduling_problem<dtime_t>::Precedence_constraints linear_prec = prec;
+	auto linear = Bench::measure([&]() {
+		linear_validate<dtime_t>(linear_prec, jobs);
+	});
+
+	std::optional<Scheduling_problem<dtime_t>> problem;
+	auto indexed = Bench::measure([&]() {
+		problem.emplace(jobs, prec, 1);
+	});
+
+	// both must resolve the references to the same jobs
+	for (std::size_t i = 0; i < prec.size(); i++) {
+		CHECK(problem->prec[i].get_fromIndex() == linear_prec[i].get_fromIndex());
+		CHECK(problem->prec[i].get_toIndex() == linear_prec[i].get_toIndex());
+	}
+
+	std::cout << std::endl << "Problem construction (jobset-pe2: " << jobs.size() << " jobs, "
+		<< prec.size() << " precedence constraints)" << std::endl;
+	// per line of the files, and per job reference of the constraints
+	Bench::report("  parse job and precedence files (per line)", parse, jobs.size() + prec.size());
+	Bench::report("  linear search (per reference)", linear, 2 * prec.size());
+	Bench::report("  Scheduling_problem, JobID index (per reference)", indexed, 2 * prec.size());
+}
@@ -0,0 +1,77 @@
+#include "doctest.h"
+
+#include <vector>
+
+#include "bench.hpp"
+#include "global/space.hpp"
+
+using namespace NP;
+
+typedef Global::Schedule_state<dtime_t> State;
+
+// Mimics the state churn of one depth of the exploration: most new states are
+// merged into an existing one right away, the survivors live until the depth is retired.
+static const unsigned int num_depths = 200;
+static const unsigned int states_per_depth = 1000;
+static const unsigned int survivors_every = 4;
+
+TEST_CASE("[bench] Schedule_state allocation: new/delete vs. per-depth pool") {
+	Scheduling_problem<dtime_t>::Workload jobs{
+		Job<dtime_t>{0, Interval<dtime_t>(0, 10), Interval<dtime_t>(3, 8), 100, 1, 0, 0},
+		Job<dtime_t>{1, Interval<dtime_t>(0, 10), Interval<dtime_t>(5, 9), 100, 2, 1, 1},
+	};
+	const unsigned int num_cpus = 4;
+	Global::State_space_data<dtime_t> data(jobs, {}, {}, num_cpus);
+	const State initial(num_cpus, data);
+	const Index_set scheduled_jobs{ Index_set(), 0 };
+	const std::vector<Job_index> pending_succ;
+	const std::vector<const Job<dtime_t>*> ready_succ;
+	const unsigned long long num_states = (unsigned long long) num_depths * states_per_depth;
+
+	auto transition = [&](unsigned int i) {
+		dtime_t offset = i % 7;
+		return std::make_tuple(Interval<dtime_t>(offset, offset + 2), Interval<dtime_t>(offset + 3, offset + 10));
+	};
+
+	auto with_new = Bench::measure([&]() {
+		std::vector<State*> survivors;
+		for (unsigned int d = 0; d < num_depths; d++) {
+			for (unsigned int i = 0; i < states_per_depth; i++) {
+				auto [st, ft] = transition(i);
+				State* s = new State(initial, 0, st, ft, scheduled_jobs, pending_succ, ready_succ, data, 0);
+				if (i % survivors_every == 0)
+					survivors.push_back(s);
+				else
+					delete s;
+			}
+			for (State* s : survivors)
+				delete s;
+			survivors.clear();
+		}
+	});
+
+	auto with_pool = Bench::measure([&]() {
+		std::vector<State*> survivors;
+		for (unsigned int d = 0; d < num_depths; d++) {
+			Global::State_pool<dtime_t> pool;
+			for (unsigned int i = 0; i < states_per_depth; i++) {
+				auto [st, ft] = transition(i);
+				State* s = pool.create(initial, 0, st, ft, scheduled_jobs, pending_succ, ready_succ, data, 0);
+				if (i % survivors_every == 0)
+					survivors.push_back(s);
+				else
+					pool.release(s);
+			}
+			for (State* s : survivors)
+				pool.release(s);
+			survivors.clear();
+		}
+	});
+
+	std::cout << std::endl << "Schedule_state allocation (m = " << num_cpus << ", per state)" << std::endl;
+	Bench::report("  new/delete", with_new, num_states);
+	Bench::report("  per-depth State_pool", with_pool, num_states);
+
+	// the pool saves (almost) one allocation per state
+	CHECK(with_pool.allocations < with_new.allocations);
+}
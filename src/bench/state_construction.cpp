@@ -0,0 +1,50 @@
+#include "doctest.h"
+
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "global/space.hpp"
+
+using namespace NP;
+
+typedef Global::Schedule_state<dtime_t> State;
+
+static const unsigned int num_transitions = 200000;
+
+// measure the construction of a successor state, i.e., a transition of the global exploration
+static void bench_state_construction(unsigned int num_cpus)
+{
+	Scheduling_problem<dtime_t>::Workload jobs{
+		Job<dtime_t>{0, Interval<dtime_t>(0, 10), Interval<dtime_t>(3, 8), 100, 1, 0, 0},
+		Job<dtime_t>{1, Interval<dtime_t>(0, 10), Interval<dtime_t>(5, 9), 100, 2, 1, 1},
+	};
+	Global::State_space_data<dtime_t> data(jobs, {}, {}, num_cpus);
+	const std::vector<Job_index> pending_succ;
+	const std::vector<const Job<dtime_t>*> ready_succ;
+
+	// start from a state in which the cores are not all available at the same time
+	const State initial(num_cpus, data);
+	const State from(initial, 0, Interval<dtime_t>(0, 2), Interval<dtime_t>(3, 8),
+		Index_set(Index_set(), 0), pending_succ, ready_succ, data, 0);
+	const Index_set scheduled_jobs{ Index_set(Index_set(), 0), 1 };
+
+	dtime_t sum = 0;
+	auto m = Bench::measure([&]() {
+		for (unsigned int i = 0; i < num_transitions; i++) {
+			dtime_t offset = i % 7;
+			State s(from, 1, Interval<dtime_t>(offset, offset + 2), Interval<dtime_t>(offset + 3, offset + 10),
+				scheduled_jobs, pending_succ, ready_succ, data, 0);
+			sum += s.core_availability(num_cpus).max();
+		}
+	});
+	// also keeps the compiler from optimizing the transitions away
+	CHECK(sum > 0);
+	Bench::report("  m = " + std::to_string(num_cpus), m, num_transitions);
+}
+
+TEST_CASE("[bench] Schedule_state construction") {
+	std::cout << std::endl << "Schedule_state construction (per transition)" << std::endl;
+	for (unsigned int num_cpus : { 2, 4, 8, 16 })
+		bench_state_construction(num_cpus);
+}
@@ -26,6 +26,7 @@
 #include "problem.hpp"
 #include "global/space.hpp"
 #include "io.hpp"
+#include "job_set_file.hpp"
 #include "clock.hpp"
 #include "memory_used.hpp"
 #include "reconfiguration/manager.hpp"
@@ -40,6 +41,17 @@ static bool want_naive;
 static bool merge_conservative;
 static bool merge_use_job_finish_times;
 static int merge_depth;
+static bool want_sorted_frontier;
+static bool want_zobrist_keys;
+static unsigned long memory_limit_mb;
+static std::string spill_dir;
+static std::string checkpoint_dir;
+static double checkpoint_interval;
+static bool want_resume;
+// checkpoint of the file being analysed
+static std::string checkpoint_file;
+static bool want_decompose;
+static double hyperperiod;
 static bool want_dense;
 
 static bool want_precedence = false;
@@ -48,12 +60,13 @@ static std::string precedence_file;
 static bool want_aborts = false;
 static std::string aborts_file;
 
+// convert the input file instead of analysing it
+static std::string convert_file;
+
 static bool want_multiprocessor = false;
 static unsigned int num_processors = 1;
 
-#ifdef CONFIG_COLLECT_SCHEDULE_GRAPH
 static bool want_dot_graph;
-#endif
 static double timeout;
 static unsigned int max_depth = 0;
 
@@ -80,11 +93,66 @@ struct Analysis_result {
 };
 
 
+// the jobs, precedence constraints and abort actions of an input file
+template<class Time>
+struct Workload {
+	typename NP::Job<Time>::Job_set jobs;
+	std::vector<NP::Precedence_constraint<Time>> edges;
+	std::vector<NP::Abort_action<Time>> aborts;
+};
+
+static bool is_binary_job_set(const std::string &fname)
+{
+	const std::string& ext = NP::Job_set_file::extension;
+	return fname.size() > ext.size() && fname.compare(fname.size() - ext.size(), ext.size(), ext) == 0;
+}
+
+template<class Time>
+static Workload<Time> parse_workload(
+	std::istream &in,
+	std::istream &prec_in,
+	const std::string &fname,
+	bool is_yaml)
+{
+	if (is_binary_job_set(fname)) {
+		if (want_precedence || want_aborts)
+			throw std::runtime_error("a binary job set already contains its precedence constraints and abort actions");
+		NP::Job_set_file::Reader<Time> file(fname);
+		return Workload<Time>{file.jobs(), file.precedence_constraints(), file.abort_actions()};
+	}
+
+	// CSV files are mapped into memory rather than read through a stream
+	Workload<Time> input;
+	input.jobs = is_yaml ? NP::parse_yaml_job_file<Time>(in)
+		: fname == "-" ? NP::parse_csv_job_file<Time>(in)
+		: NP::parse_csv_job_file<Time>(NP::Mapped_file(fname));
+	// Parse precedence constraints
+	if (is_yaml)
+		input.edges = NP::parse_yaml_dag_file<Time>(prec_in);
+	else if (want_precedence)
+		input.edges = NP::parse_precedence_file<Time>(NP::Mapped_file(precedence_file));
+	if (want_aborts)
+		input.aborts = NP::parse_abort_file<Time>(NP::Mapped_file(aborts_file));
+	return input;
+}
+
+// writes the workload of the input file to convert_file, in the binary format
+template<class Time>
+static void convert(
+	std::istream &in,
+	std::istream &prec_in,
+	const std::string &fname,
+	bool is_yaml)
+{
+	Workload<Time> input = parse_workload<Time>(in, prec_in, fname, is_yaml);
+	NP::Job_set_file::write<Time>(convert_file, input.jobs, input.edges, input.aborts);
+}
+
 template<class Time, class Space>
 static Analysis_result analyze(
 	std::istream &in,
 	std::istream &prec_in,
-	std::istream &aborts_in,
+	const std::string &fname,
     bool &is_yaml)
 {
 #ifdef CONFIG_PARALLEL
@@ -93,14 +161,12 @@ static Analysis_result analyze(
 
 
 	// Parse input files and create NP scheduling problem description
-    typename NP::Job<Time>::Job_set jobs = is_yaml ? NP::parse_yaml_job_file<Time>(in) : NP::parse_csv_job_file<Time>(in);
-	// Parse precedence constraints
-	std::vector<NP::Precedence_constraint<Time>> edges = is_yaml ? NP::parse_yaml_dag_file<Time>(prec_in) : NP::parse_precedence_file<Time>(prec_in);
+	Workload<Time> input = parse_workload<Time>(in, prec_in, fname, is_yaml);
 
 	NP::Scheduling_problem<Time> problem{
-        jobs,
-		edges,
-		NP::parse_abort_file<Time>(aborts_in),
+		input.jobs,
+		input.edges,
+		input.aborts,
 		num_processors};
 
 	if (feasibility_options.run_necessary) {
@@ -149,16 +215,24 @@ static Analysis_result analyze(
 	opts.merge_conservative = merge_conservative;
 	opts.merge_depth = merge_depth;
 	opts.merge_use_job_finish_times = merge_use_job_finish_times;
+	opts.sort_frontier = want_sorted_frontier;
+	opts.zobrist_keys = want_zobrist_keys;
+	opts.collect_schedule_graph = want_dot_graph;
+	opts.memory_limit = (std::size_t)memory_limit_mb << 20;
+	opts.spill_dir = spill_dir;
+	opts.checkpoint_file = checkpoint_file;
+	opts.checkpoint_interval = checkpoint_interval;
+	opts.resume = want_resume;
+	opts.decompose = want_decompose;
+	opts.hyperperiod = hyperperiod;
 
 	// Actually call the analysis engine
 	auto space = Space::explore(problem, opts);
 
 	// Extract the analysis results
 	auto graph = std::ostringstream();
-#ifdef CONFIG_COLLECT_SCHEDULE_GRAPH
 	if (want_dot_graph)
 		graph << *space;
-#endif
 
 	auto rta = std::ostringstream();
 
@@ -180,13 +254,24 @@ static Analysis_result analyze(
 
 	auto width_stream = std::ostringstream();
 	if (want_width_file) {
-		width_stream << "Depth, Width (#Nodes), Width (#States)" << std::endl;
+		width_stream << "Depth, Width (#Nodes), Width (#States)"
+#ifdef CONFIG_PARALLEL
+		             << ", Thread utilization"
+#endif
+		             << std::endl;
 		const std::vector<std::pair<unsigned long, unsigned long>>& width = space->evolution_exploration_front_width();
+#ifdef CONFIG_PARALLEL
+		const std::vector<double>& utilization = space->evolution_thread_utilization();
+#endif
 		for (int d = 0; d < problem.jobs.size(); d++) {
 			width_stream << d << ", "
 					   << width[d].first
 					   << ", "
 					   << width[d].second
+#ifdef CONFIG_PARALLEL
+					   << ", "
+					   << utilization[d]
+#endif
 					   << std::endl;
 		}
 	}
@@ -211,17 +296,17 @@ static Analysis_result analyze(
 static Analysis_result process_stream(
 	std::istream &in,
 	std::istream &prec_in,
-	std::istream &aborts_in,
+	const std::string &fname,
     bool is_yaml)
 {
 	if (want_multiprocessor && want_dense)
-		return analyze<dense_t, NP::Global::State_space<dense_t>>(in, prec_in, aborts_in, is_yaml);
+		return analyze<dense_t, NP::Global::State_space<dense_t>>(in, prec_in, fname, is_yaml);
 	else if (want_multiprocessor && !want_dense)
-		return analyze<dtime_t, NP::Global::State_space<dtime_t>>(in, prec_in, aborts_in, is_yaml);
+		return analyze<dtime_t, NP::Global::State_space<dtime_t>>(in, prec_in, fname, is_yaml);
 	else if (want_dense)
-		return analyze<dense_t, NP::Global::State_space<dense_t>>(in, prec_in, aborts_in, is_yaml);
+		return analyze<dense_t, NP::Global::State_space<dense_t>>(in, prec_in, fname, is_yaml);
 	else
-		return analyze<dtime_t, NP::Global::State_space<dtime_t>>(in, prec_in, aborts_in, is_yaml);
+		return analyze<dtime_t, NP::Global::State_space<dtime_t>>(in, prec_in, fname, is_yaml);
 }
 
 static void process_file(const std::string& fname)
@@ -229,45 +314,57 @@ static void process_file(const std::string& fname)
 	try {
 		Analysis_result result;
 
+		// the streams are only read for YAML files and stdin, CSV files are mapped (see analyze())
 		auto empty_dag_stream = std::istringstream("\n");
-		auto empty_aborts_stream = std::istringstream("\n");
 		auto dag_stream = std::ifstream();
-		auto aborts_stream = std::ifstream();
 
 		if (want_precedence)
 			dag_stream.open(precedence_file);
 
-		if (want_aborts)
-			aborts_stream.open(aborts_file);
-
 		std::istream &dag_in = want_precedence ?
 			static_cast<std::istream&>(dag_stream) :
 			static_cast<std::istream&>(empty_dag_stream);
 
-		std::istream &aborts_in = want_aborts ?
-			static_cast<std::istream&>(aborts_stream) :
-			static_cast<std::istream&>(empty_aborts_stream);
+		if (!checkpoint_dir.empty())
+			checkpoint_file = checkpoint_dir + "/"
+				+ (fname == "-" ? std::string("stdin") : fname.substr(fname.find_last_of("/\\") + 1))
+				+ ".checkpoint";
+
+		// check the extension of the file
+		std::string ext = fname.substr(fname.find_last_of(".") + 1);
+		bool is_yaml = fname != "-" && (ext == "yaml" || ext == "yml");
+
+		if (!convert_file.empty())
+		{
+			auto file_in = std::ifstream();
+			if (is_yaml)
+				file_in.open(fname, std::ios::in);
+			std::istream &in = fname == "-" ? std::cin : static_cast<std::istream&>(file_in);
+			if (want_dense)
+				convert<dense_t>(in, dag_in, fname, is_yaml);
+			else
+				convert<dtime_t>(in, dag_in, fname, is_yaml);
+			return;
+		}
 
 		if (fname == "-")
 		{
-			result = process_stream(std::cin, dag_in, aborts_in, false);
+			result = process_stream(std::cin, dag_in, fname, false);
 		}
 		else {
-            // check the extension of the file
-            std::string ext = fname.substr(fname.find_last_of(".") + 1);
-            bool is_yaml = false;
-            if (ext == "yaml" || ext == "yml") {
-                is_yaml = true;
-            }
+			// the extension that the names of the output files replace
+			const std::string input_ext = is_yaml ? ".yaml"
+				: is_binary_job_set(fname) ? NP::Job_set_file::extension : ".csv";
 
-			auto in = std::ifstream(fname, std::ios::in);
-			result = process_stream(in, dag_in, aborts_in, is_yaml);
+			auto in = std::ifstream();
+			if (is_yaml)
+				in.open(fname, std::ios::in);
+			result = process_stream(in, dag_in, fname, is_yaml);
 
-#ifdef CONFIG_COLLECT_SCHEDULE_GRAPH
 			if (want_dot_graph) {
 				DM("\nDot graph being made\n");
 				std::string dot_name = fname;
-				auto p = is_yaml ? dot_name.find(".yaml") : dot_name.find(".csv");
+				auto p = dot_name.find(input_ext);
 				if (p != std::string::npos) {
 					dot_name.replace(p, std::string::npos, ".dot");
 					auto out  = std::ofstream(dot_name,  std::ios::out);
@@ -275,10 +372,9 @@ static void process_file(const std::string& fname)
 					out.close();
 				}
 			}
-#endif
 			if (want_rta_file) {
 				std::string rta_name = fname;
-				auto p = is_yaml ? rta_name.find(".yaml") : rta_name.find(".csv");
+				auto p = rta_name.find(input_ext);
 				if (p != std::string::npos) {
 					rta_name.replace(p, std::string::npos, ".rta.csv");
 					auto out  = std::ofstream(rta_name,  std::ios::out);
@@ -289,7 +385,7 @@ static void process_file(const std::string& fname)
 
 			if (want_width_file) {
 				std::string width_file_name = fname;
-				auto p = is_yaml ? width_file_name.find(".yaml") : width_file_name.find(".csv");
+				auto p = width_file_name.find(input_ext);
 				if (p != std::string::npos) {
 					width_file_name.replace(p, std::string::npos, ".width.csv");
 					auto out = std::ofstream(width_file_name, std::ios::out);
@@ -381,6 +477,49 @@ int main(int argc, char** argv)
 		.choices({ "no", "c1", "c2", "l1", "l2", "l3", "lmax"}).choices({ "no", "c1", "c2","l1","l2","l3","lmax"}).set_default("l1")
 		.help("choose type of state merging approach used during the analysis. 'no': no merging, 'c1': conservative level 1, 'c2': conservative level 2, 'lx': lossy with depth=x, 'lmax': lossy with max depth. (default: l1)");
 
+	parser.add_option("--frontier").dest("frontier")
+		.metavar("STRATEGY")
+		.choices({ "hash", "sort" }).set_default("hash")
+		.help("choose how the nodes of the next depth are found: 'hash': look up every new set of scheduled jobs in a hash table, 'sort': sort all transitions of a depth by their set of scheduled jobs (default: hash)");
+
+	parser.add_option("--node-keys").dest("node_keys")
+		.metavar("KEYS")
+		.choices({ "jobs", "zobrist" }).set_default("jobs")
+		.help("choose how the nodes are identified: 'jobs': by keys derived from the scheduled jobs, compared with the sets of scheduled jobs on lookup, 'zobrist': by random 128-bit keys of the scheduled jobs, which are trusted on lookup (global analysis only, default: jobs)");
+
+	parser.add_option("--memory-limit").dest("memory_limit")
+		.metavar("MB")
+		.set_default("0")
+		.help("move the nodes of the next depth to disk when they need more than MB megabytes of memory, and explore them in parts (global analysis only, default: no limit)");
+
+	parser.add_option("--checkpoint-dir").dest("checkpoint_dir")
+		.metavar("DIR")
+		.set_default("")
+		.help("regularly save the progress of the analysis of each input file to DIR, such that it can be resumed with --resume (global analysis only, default: off)");
+
+	parser.add_option("--checkpoint-interval").dest("checkpoint_interval")
+		.metavar("SECONDS")
+		.set_default("60")
+		.help("minimum CPU time between two checkpoints (default: 60)");
+
+	parser.add_option("--resume").dest("resume").set_default("0")
+		.action("store_const").set_const("1")
+		.help("continue the analysis of each input file from its checkpoint in the directory given with --checkpoint-dir, if there is one (default: off)");
+
+	parser.add_option("--spill-dir").dest("spill_dir")
+		.metavar("DIR")
+		.set_default("")
+		.help("directory of the files written because of --memory-limit (default: the system's temporary directory)");
+
+	parser.add_option("--decompose").dest("decompose").set_default("0")
+		.action("store_const").set_const("1")
+		.help("split the jobs at points in time where all cores are certainly idle, and analyse the resulting segments separately (global analysis only, default: off)");
+
+	parser.add_option("--hyperperiod").dest("hyperperiod")
+		.metavar("H")
+		.set_default("0")
+		.help("the job set repeats every H time units: stop the analysis once it repeats itself, and derive the response times of the remaining jobs (global analysis only, default: off)");
+
 	parser.add_option("-t", "--time").dest("time_model")
 	      .metavar("TIME-MODEL")
 	      .choices({"dense", "discrete"}).set_default("discrete")
@@ -406,6 +545,11 @@ int main(int argc, char** argv)
 	      .help("name of the file that contains the job set's abort actions")
 	      .set_default("");
 
+	parser.add_option("--convert").dest("convert_file")
+	      .metavar("FILE")
+	      .help("instead of analysing the job set, write it with its precedence DAG and abort actions to FILE in the binary job set format, which is loaded without parsing; files ending in .npjobs are read in this format (in the time model chosen with --time)")
+	      .set_default("");
+
 	parser.add_option("-m", "--multiprocessor").dest("num_processors")
 	      .help("set the number of processors of the platform")
 	      .set_default("1");
@@ -542,6 +686,20 @@ int main(int argc, char** argv)
 	else
 		merge_depth = 1;
 
+	want_sorted_frontier = (const std::string&)options.get("frontier") == "sort";
+	want_zobrist_keys = (const std::string&)options.get("node_keys") == "zobrist";
+	memory_limit_mb = options.get("memory_limit");
+	spill_dir = (const std::string&)options.get("spill_dir");
+	checkpoint_dir = (const std::string&)options.get("checkpoint_dir");
+	checkpoint_interval = options.get("checkpoint_interval");
+	want_resume = options.get("resume");
+	if (want_resume && checkpoint_dir.empty()) {
+		std::cerr << "Error: --resume requires --checkpoint-dir" << std::endl;
+		return 1;
+	}
+	want_decompose = options.get("decompose");
+	hyperperiod = options.get("hyperperiod");
+
 	std::string time_model = (const std::string&)options.get("time_model");
 	want_dense = time_model == "dense";
 
@@ -574,6 +732,12 @@ int main(int argc, char** argv)
 	}
 	aborts_file = (const std::string&) options.get("abort_file");
 
+	convert_file = (const std::string&) options.get("convert_file");
+	if (!convert_file.empty() && parser.args().size() > 1) {
+		std::cerr << "Error: --convert takes a single job set" << std::endl;
+		return 1;
+	}
+
 	want_multiprocessor = options.is_set_by_user("num_processors");
 	num_processors = options.get("num_processors");
 	if (!num_processors || num_processors > MAX_PROCESSORS) {
@@ -614,17 +778,8 @@ int main(int argc, char** argv)
 	reconfigure_options.use_random_analysis = options.get("reconfigure-random-trials");
 	reconfigure_options.minimize_timeout = options.get("reconfigure-minimize-timeout");
 
-#ifdef CONFIG_COLLECT_SCHEDULE_GRAPH
 	want_dot_graph = options.get("dot");
 	DM("Dot graph"<<want_dot_graph<<std::endl);
-#else
-	if (options.is_set_by_user("dot")) {
-		std::cerr << "Error: graph collection support must be enabled "
-		          << "during compilation (CONFIG_COLLECT_SCHEDULE_GRAPH "
-		          << "is not set)." << std::endl;
-		return 2;
-	}
-#endif
 
 #ifdef CONFIG_PARALLEL
 	num_worker_threads = options.get("num_threads");
@@ -0,0 +1,79 @@
+#include "doctest.h"
+
+#include <vector>
+
+#include "interval.hpp"
+#include "global/availability_intervals.hpp"
+
+using namespace NP::Global;
+
+template<class Time> static void fill(Availability_intervals<Time>& cav, const std::vector<Interval<Time>>& intervals)
+{
+	cav.reserve(intervals.size());
+	for (const auto& i : intervals)
+		cav.emplace_back(i.min(), i.max());
+}
+
+// compares the kernels with the Interval operations for every number of cores up to 12,
+// such that both the inline and the heap storage, and the vectorized loops and their tails, are covered
+template<class Time> static void check_against_intervals()
+{
+	unsigned long long seed = 1;
+	auto next = [&seed](int bound) {
+		seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+		return Time((seed >> 33) % bound);
+	};
+
+	for (unsigned int n = 1; n <= 12; n++) {
+		for (int round = 0; round < 50; round++) {
+			std::vector<Interval<Time>> a, b;
+			for (unsigned int i = 0; i < n; i++) {
+				Time a_min = next(10);
+				a.emplace_back(a_min, a_min + next(10));
+				// b is often contained in a to also cover the positive cases
+				if (round % 2 == 0)
+					b.emplace_back(a_min + next(2), a_min + next(2));
+				else {
+					Time b_min = next(20);
+					b.emplace_back(b_min, b_min + next(5));
+				}
+			}
+			Availability_intervals<Time> cav_a, cav_b;
+			fill(cav_a, a);
+			fill(cav_b, b);
+
+			bool contains = true, intersects = true;
+			for (unsigned int i = 0; i < n; i++) {
+				contains &= a[i].contains(b[i]);
+				intersects &= a[i].intersects(b[i]);
+			}
+			CHECK(cav_a.contains(cav_b) == contains);
+			CHECK(cav_a.intersects(cav_b) == intersects);
+
+			cav_a.widen(cav_b);
+			REQUIRE(cav_a.size() == n);
+			for (unsigned int i = 0; i < n; i++)
+				CHECK(cav_a[i] == (a[i] | b[i]));
+		}
+	}
+}
+
+TEST_CASE("[global] Availability_intervals kernels (discrete time)") {
+	check_against_intervals<dtime_t>();
+}
+
+TEST_CASE("[global] Availability_intervals kernels (dense time)") {
+	check_against_intervals<dense_t>();
+}
+
+TEST_CASE("[global] Availability_intervals construction") {
+	Availability_intervals<dtime_t> few(3, Interval<dtime_t>(1, 2));
+	CHECK(few.size() == 3);
+	CHECK(few[2] == Interval<dtime_t>(1, 2));
+
+	Availability_intervals<dtime_t> many(20, Interval<dtime_t>(5, 5));
+	CHECK(many.size() == 20);
+	many.set(19, Interval<dtime_t>(7, 3));
+	CHECK(many[19] == Interval<dtime_t>(3, 7));
+	CHECK(many[0] == Interval<dtime_t>(5, 5));
+}
@@ -3,6 +3,7 @@
 
 #include <algorithm>
 #include <iostream>
+#include <sstream>
 
 #include "index_set.hpp"
 #include "jobs.hpp"
@@ -142,3 +143,61 @@ TEST_CASE("[basic] index set")
 	for (size_t index = 0; index < 50; index++) CHECK(!copy_c.contains(index));
 }
 
+
+TEST_CASE("[basic] index set derived by adding an index")
+{
+	NP::Index_set some;
+	some.add(10);
+	some.add(20);
+
+	CHECK(NP::Index_set(some, 30).is_derived_from(some, 30));
+	CHECK(NP::Index_set(some, 130).is_derived_from(some, 130));
+	CHECK(!NP::Index_set(some, 30).is_derived_from(some, 31));
+	// the added index must be in the set
+	CHECK(!some.is_derived_from(NP::Index_set(some, 30), 30));
+	// all other indices must be the same
+	CHECK(!NP::Index_set(NP::Index_set(some, 30), 40).is_derived_from(some, 30));
+	CHECK(!NP::Index_set(some, 30).is_derived_from(NP::Index_set(some, 40), 30));
+	CHECK(NP::Index_set(NP::Index_set(), 0).is_derived_from(NP::Index_set(), 0));
+}
+
+TEST_CASE("[basic] index set word operations")
+{
+	// several words, such that vectorized kernels and their scalar tails are used
+	NP::Index_set a, b;
+	for (std::size_t i = 0; i < 600; i += 3)
+		a.add(i);
+	for (std::size_t i = 0; i < 600; i += 6)
+		b.add(i);
+	CHECK(a.size() == 200);
+	CHECK(b.size() == 100);
+	CHECK(b.is_subset_of(a));
+	CHECK(!a.is_subset_of(b));
+
+	NP::Index_set diff(a, b);
+	CHECK(diff.size() == 100);
+	CHECK(diff.contains(3));
+	CHECK(!diff.contains(6));
+
+	NP::Index_set c;
+	c.copy_from(a);
+	CHECK(c == a);
+	c.add(599);
+	CHECK(c != a);
+	CHECK(a.is_subset_of(c));
+
+	// a set that is longer than the other one
+	NP::Index_set longer;
+	longer.copy_from(b);
+	longer.add(1000);
+	CHECK(!longer.is_subset_of(a));
+	CHECK(b.is_subset_of(longer));
+	CHECK(longer != b);
+	CHECK(NP::Index_set(longer, b).size() == 1);
+	CHECK(NP::Index_set(b, longer).size() == 0);
+	CHECK(longer.is_derived_from(b, 1000));
+
+	std::ostringstream out;
+	out << NP::Index_set(NP::Index_set(NP::Index_set(), 64), 3);
+	CHECK(out.str() == "{3, 64}");
+}
@@ -439,3 +439,385 @@ TEST_CASE("[global] explore across bucket boundaries") {
 	delete nspace;
 }
 
+
+static void check_sorted_frontier(const NP::Job<dtime_t>::Job_set& jobs, unsigned int num_cpus)
+{
+	NP::Scheduling_problem<dtime_t> prob{jobs, num_cpus};
+	NP::Analysis_options opts;
+
+	auto space = NP::Global::State_space<dtime_t>::explore(prob, opts);
+	opts.sort_frontier = true;
+	auto sspace = NP::Global::State_space<dtime_t>::explore(prob, opts);
+
+	CHECK(sspace->is_schedulable() == space->is_schedulable());
+	if (space->is_schedulable()) {
+		CHECK(sspace->number_of_nodes() == space->number_of_nodes());
+		CHECK(sspace->number_of_states() == space->number_of_states());
+		CHECK(sspace->number_of_edges() == space->number_of_edges());
+		for (const auto& j : jobs)
+			CHECK(sspace->get_finish_times(j) == space->get_finish_times(j));
+	}
+	delete space;
+	delete sspace;
+}
+
+TEST_CASE("[global] Build the next depth by sorting") {
+	auto in = std::istringstream(fig1a_jobs_file);
+	auto fig1a_jobs = NP::parse_csv_job_file<dtime_t>(in);
+	check_sorted_frontier(fig1a_jobs, 1);
+	check_sorted_frontier(fig1a_jobs, 2);
+
+	auto in2 = std::istringstream(global_fig1_file);
+	check_sorted_frontier(NP::parse_csv_job_file<dtime_t>(in2), 2);
+
+	// many nodes per depth: independent jobs with wide release jitter
+	NP::Job<dtime_t>::Job_set jobs;
+	for (unsigned int i = 0; i < 12; i++)
+		jobs.push_back(NP::Job<dtime_t>{i + 1, Interval<dtime_t>(10 * (i / 3), 10 * (i / 3) + 25),
+			Interval<dtime_t>(2, 6), 500, i % 4, i, i});
+	check_sorted_frontier(jobs, 2);
+	check_sorted_frontier(jobs, 3);
+}
+
+static void check_zobrist_keys(const NP::Job<dtime_t>::Job_set& jobs, unsigned int num_cpus, bool sort_frontier)
+{
+	NP::Scheduling_problem<dtime_t> prob{jobs, num_cpus};
+	NP::Analysis_options opts;
+	opts.sort_frontier = sort_frontier;
+
+	auto space = NP::Global::State_space<dtime_t>::explore(prob, opts);
+	opts.zobrist_keys = true;
+	auto zspace = NP::Global::State_space<dtime_t>::explore(prob, opts);
+
+	CHECK(zspace->is_schedulable() == space->is_schedulable());
+	CHECK(zspace->number_of_nodes() == space->number_of_nodes());
+	CHECK(zspace->number_of_states() == space->number_of_states());
+	CHECK(zspace->number_of_edges() == space->number_of_edges());
+	for (const auto& j : jobs)
+		CHECK(zspace->get_finish_times(j) == space->get_finish_times(j));
+	// every set of scheduled jobs has its own key
+	CHECK(zspace->number_of_key_matches() == space->number_of_key_matches() - space->number_of_key_collisions());
+	CHECK(zspace->number_of_key_collisions() == 0);
+	delete space;
+	delete zspace;
+}
+
+TEST_CASE("[global] Identify nodes by Zobrist keys") {
+	auto in = std::istringstream(fig1a_jobs_file);
+	auto fig1a_jobs = NP::parse_csv_job_file<dtime_t>(in);
+	check_zobrist_keys(fig1a_jobs, 2, false);
+
+	NP::Job<dtime_t>::Job_set jobs;
+	for (unsigned int i = 0; i < 12; i++)
+		jobs.push_back(NP::Job<dtime_t>{i + 1, Interval<dtime_t>(10 * (i / 3), 10 * (i / 3) + 25),
+			Interval<dtime_t>(2, 6), 500, i % 4, i, i});
+	check_zobrist_keys(jobs, 2, false);
+	check_zobrist_keys(jobs, 2, true);
+}
+
+static void check_schedule_graph(const NP::Job<dtime_t>::Job_set& jobs, unsigned int num_cpus, bool sort_frontier)
+{
+	NP::Scheduling_problem<dtime_t> prob{jobs, num_cpus};
+	NP::Analysis_options opts;
+	opts.sort_frontier = sort_frontier;
+	opts.collect_schedule_graph = true;
+
+	auto space = NP::Global::State_space<dtime_t>::explore(prob, opts);
+	CHECK(space->is_schedulable());
+	CHECK(space->get_graph_nodes().size() == space->number_of_nodes());
+	CHECK(space->get_edges().size() == space->number_of_edges());
+	for (const auto& e : space->get_edges()) {
+		CHECK(e.source < e.target);
+		CHECK(e.target < space->get_graph_nodes().size());
+	}
+
+	std::ostringstream dot;
+	dot << *space;
+	CHECK(dot.str().find("digraph {") == 0);
+	CHECK(dot.str().find("N0 -> N1") != std::string::npos);
+	delete space;
+}
+
+TEST_CASE("[global] Collect the schedule graph") {
+	auto in = std::istringstream(fig1a_jobs_file);
+	auto fig1a_jobs = NP::parse_csv_job_file<dtime_t>(in);
+	check_schedule_graph(fig1a_jobs, 2, false);
+	check_schedule_graph(fig1a_jobs, 2, true);
+
+	NP::Scheduling_problem<dtime_t> prob{fig1a_jobs, 2};
+	NP::Analysis_options opts;
+	auto space = NP::Global::State_space<dtime_t>::explore(prob, opts);
+	CHECK(space->get_edges().empty());
+	CHECK(space->get_graph_nodes().empty());
+	delete space;
+}
+
+static void check_spilled_exploration(const NP::Job<dtime_t>::Job_set& jobs, unsigned int num_cpus)
+{
+	NP::Scheduling_problem<dtime_t> prob{jobs, num_cpus};
+	NP::Analysis_options opts;
+
+	auto space = NP::Global::State_space<dtime_t>::explore(prob, opts);
+	// small enough that the next depth is moved to disk after every node
+	opts.memory_limit = 1;
+	auto sspace = NP::Global::State_space<dtime_t>::explore(prob, opts);
+
+	CHECK(sspace->number_of_spilled_nodes() > 0);
+	CHECK(space->number_of_spilled_nodes() == 0);
+	CHECK(sspace->is_schedulable() == space->is_schedulable());
+	if (space->is_schedulable()) {
+		CHECK(sspace->number_of_nodes() == space->number_of_nodes());
+		CHECK(sspace->number_of_edges() == space->number_of_edges());
+		CHECK(sspace->max_exploration_front_width() == space->max_exploration_front_width());
+		for (const auto& j : jobs)
+			CHECK(sspace->get_finish_times(j) == space->get_finish_times(j));
+	}
+	delete space;
+	delete sspace;
+}
+
+TEST_CASE("[global] Explore with a memory limit") {
+	auto in = std::istringstream(fig1a_jobs_file);
+	auto fig1a_jobs = NP::parse_csv_job_file<dtime_t>(in);
+	check_spilled_exploration(fig1a_jobs, 1);
+	check_spilled_exploration(fig1a_jobs, 2);
+
+	NP::Job<dtime_t>::Job_set jobs;
+	for (unsigned int i = 0; i < 12; i++)
+		jobs.push_back(NP::Job<dtime_t>{i + 1, Interval<dtime_t>(10 * (i / 3), 10 * (i / 3) + 25),
+			Interval<dtime_t>(2, 6), 500, i % 4, i, i});
+	check_spilled_exploration(jobs, 2);
+	check_spilled_exploration(jobs, 3);
+}
+
+static void check_resumed_exploration(const NP::Job<dtime_t>::Job_set& jobs, unsigned int num_cpus, std::size_t memory_limit)
+{
+	const std::string checkpoint = "global_test.checkpoint";
+	std::remove(checkpoint.c_str());
+
+	NP::Scheduling_problem<dtime_t> prob{jobs, num_cpus};
+	NP::Analysis_options opts;
+	opts.memory_limit = memory_limit;
+	auto space = NP::Global::State_space<dtime_t>::explore(prob, opts);
+
+	// stop half-way, but keep the checkpoint
+	opts.checkpoint_file = checkpoint;
+	opts.max_depth = jobs.size() / 2;
+	auto partial = NP::Global::State_space<dtime_t>::explore(prob, opts);
+	CHECK(!partial->is_schedulable());
+	CHECK(std::ifstream(checkpoint).good());
+
+	opts.max_depth = 0;
+	opts.resume = true;
+	auto resumed = NP::Global::State_space<dtime_t>::explore(prob, opts);
+	CHECK(resumed->resumed_at_depth() == jobs.size() / 2 + 1);
+	CHECK(resumed->is_schedulable() == space->is_schedulable());
+	CHECK(resumed->number_of_nodes() == space->number_of_nodes());
+	CHECK(resumed->number_of_states() == space->number_of_states());
+	CHECK(resumed->number_of_edges() == space->number_of_edges());
+	CHECK(resumed->evolution_exploration_front_width() == space->evolution_exploration_front_width());
+	for (const auto& j : jobs)
+		CHECK(resumed->get_finish_times(j) == space->get_finish_times(j));
+	// a complete analysis removes its checkpoint
+	CHECK(!std::ifstream(checkpoint).good());
+
+	delete space;
+	delete partial;
+	delete resumed;
+}
+
+TEST_CASE("[global] Resume from a checkpoint") {
+	auto in = std::istringstream(fig1a_jobs_file);
+	auto fig1a_jobs = NP::parse_csv_job_file<dtime_t>(in);
+	check_resumed_exploration(fig1a_jobs, 2, 0);
+
+	NP::Job<dtime_t>::Job_set jobs;
+	for (unsigned int i = 0; i < 12; i++)
+		jobs.push_back(NP::Job<dtime_t>{i + 1, Interval<dtime_t>(10 * (i / 3), 10 * (i / 3) + 25),
+			Interval<dtime_t>(2, 6), 500, i % 4, i, i});
+	check_resumed_exploration(jobs, 2, 0);
+	check_resumed_exploration(jobs, 3, 1);
+
+	// a checkpoint cannot be resumed with another problem
+	NP::Analysis_options opts;
+	opts.checkpoint_file = "global_test.checkpoint";
+	opts.max_depth = 4;
+	delete NP::Global::State_space<dtime_t>::explore(NP::Scheduling_problem<dtime_t>{jobs, 2}, opts);
+	opts.max_depth = 0;
+	opts.resume = true;
+	CHECK_THROWS_AS(NP::Global::State_space<dtime_t>::explore(NP::Scheduling_problem<dtime_t>{jobs, 3}, opts), std::runtime_error);
+	std::remove("global_test.checkpoint");
+}
+
+static void check_decomposed_exploration(const NP::Scheduling_problem<dtime_t>& prob, std::size_t segments)
+{
+	NP::Analysis_options opts;
+	opts.early_exit = false;
+	auto space = NP::Global::State_space<dtime_t>::explore(prob, opts);
+	CHECK(space->number_of_segments() == 1);
+
+	opts.decompose = true;
+	auto decomposed = NP::Global::State_space<dtime_t>::explore(prob, opts);
+	CHECK(decomposed->number_of_segments() == segments);
+	CHECK(decomposed->is_schedulable() == space->is_schedulable());
+	CHECK(decomposed->max_exploration_front_width() <= space->max_exploration_front_width());
+	for (const auto& j : prob.jobs)
+		CHECK(decomposed->get_finish_times(j) == space->get_finish_times(j));
+
+	delete space;
+	delete decomposed;
+}
+
+TEST_CASE("[global] Decompose at idle points") {
+	// four bursts of three jobs, 100 time units apart
+	NP::Job<dtime_t>::Job_set jobs;
+	for (unsigned int i = 0; i < 12; i++)
+		jobs.push_back(NP::Job<dtime_t>{i + 1, Interval<dtime_t>(100 * (i / 3), 100 * (i / 3) + 5),
+			Interval<dtime_t>(2, 10 + i % 3), 100 * (i / 3) + 30, i % 3, i, i});
+	check_decomposed_exploration(NP::Scheduling_problem<dtime_t>{jobs, 2}, 4);
+
+	// the bursts are analysed in the order of their arrivals, not of the jobs
+	std::reverse(jobs.begin(), jobs.end());
+	for (unsigned int i = 0; i < 12; i++)
+		jobs[i] = NP::Job<dtime_t>{jobs[i].get_job_id(), jobs[i].arrival_window(), jobs[i].get_all_costs(),
+			jobs[i].get_deadline(), jobs[i].get_priority(), i, jobs[i].get_task_id()};
+	check_decomposed_exploration(NP::Scheduling_problem<dtime_t>{jobs, 2}, 4);
+
+	// no split across a precedence constraint, even if the jobs finish in time
+	NP::Scheduling_problem<dtime_t>::Precedence_constraints prec;
+	prec.push_back(NP::Precedence_constraint<dtime_t>{jobs[0].get_id(), jobs[5].get_id(), Interval<dtime_t>(0, 0)});
+	check_decomposed_exploration(NP::Scheduling_problem<dtime_t>{jobs, prec, 2}, 3);
+
+	// bursts that overlap with the next one are analysed together
+	jobs[6] = NP::Job<dtime_t>{jobs[6].get_job_id(), jobs[6].arrival_window(), Interval<dtime_t>(50, 95),
+		1000, jobs[6].get_priority(), 6, jobs[6].get_task_id()};
+	check_decomposed_exploration(NP::Scheduling_problem<dtime_t>{jobs, prec, 2}, 2);
+
+	// deadline misses are found in any segment
+	jobs[10] = NP::Job<dtime_t>{jobs[10].get_job_id(), jobs[10].arrival_window(), Interval<dtime_t>(2, 40),
+		jobs[10].get_deadline(), jobs[10].get_priority(), 10, jobs[10].get_task_id()};
+	NP::Analysis_options opts;
+	opts.decompose = true;
+	auto space = NP::Global::State_space<dtime_t>::explore(NP::Scheduling_problem<dtime_t>{jobs, prec, 2}, opts);
+	CHECK(!space->is_schedulable());
+	delete space;
+}
+
+TEST_CASE("[global] Stop when the exploration repeats every hyperperiod") {
+	// three tasks with periods 10, 20 and 40, unrolled over five hyperperiods
+	NP::Job<dtime_t>::Job_set jobs;
+	const dtime_t periods[] = { 10, 20, 40 };
+	const dtime_t costs[] = { 3, 5, 8 };
+	for (dtime_t t = 0; t < 200; t += 10)
+		for (unsigned long task = 0; task < 3; task++)
+			if (t % periods[task] == 0)
+				jobs.push_back(NP::Job<dtime_t>{t / periods[task] + 1, Interval<dtime_t>(t, t + 2),
+					Interval<dtime_t>(costs[task] / 2, costs[task]), t + periods[task], task, jobs.size(), task + 1});
+
+	NP::Scheduling_problem<dtime_t> prob{ jobs, 2 };
+	NP::Analysis_options opts;
+	auto space = NP::Global::State_space<dtime_t>::explore(prob, opts);
+	CHECK(space->periodic_at_depth() == 0);
+
+	opts.hyperperiod = 40;
+	auto periodic = NP::Global::State_space<dtime_t>::explore(prob, opts);
+	CHECK(periodic->periodic_at_depth() > 0);
+	CHECK(periodic->periodic_at_depth() < jobs.size());
+	CHECK(periodic->number_of_nodes() < space->number_of_nodes());
+	CHECK(periodic->is_schedulable() == space->is_schedulable());
+	for (const auto& j : jobs)
+		CHECK(periodic->get_finish_times(j).contains(space->get_finish_times(j)));
+
+	// the jobs do not repeat every 30 time units
+	opts.hyperperiod = 30;
+	auto not_periodic = NP::Global::State_space<dtime_t>::explore(prob, opts);
+	CHECK(not_periodic->periodic_at_depth() == 0);
+	CHECK(not_periodic->number_of_nodes() == space->number_of_nodes());
+
+	delete space;
+	delete periodic;
+	delete not_periodic;
+}
+
+// a state in which the cores become available in the given intervals,
+// no job is certainly running, and no job has a pending successor
+static NP::Global::Schedule_state<dtime_t>* make_state(std::vector<Interval<dtime_t>> cores,
+	dtime_t successor_ready = Time_model::constants<dtime_t>::infinity())
+{
+	NP::Global::Spill_writer w;
+	w.put(successor_ready);
+	w.put(Time_model::constants<dtime_t>::infinity());
+	w.put((unsigned int)cores.size());
+	for (const auto& c : cores) {
+		w.put(c.min());
+		w.put(c.max());
+	}
+	w.put((std::size_t)0);
+	w.put((std::size_t)0);
+	NP::Global::Spill_reader r(w.data(), w.data() + w.size());
+	return new NP::Global::Schedule_state<dtime_t>(r);
+}
+
+TEST_CASE("[global] Drop dominated states") {
+	auto a = make_state({ Interval<dtime_t>(0, 10), Interval<dtime_t>(5, 20) });
+	auto b = make_state({ Interval<dtime_t>(2, 8), Interval<dtime_t>(6, 15) });
+	auto c = make_state({ Interval<dtime_t>(2, 8), Interval<dtime_t>(6, 25) });
+	auto d = make_state({ Interval<dtime_t>(2, 8), Interval<dtime_t>(6, 15) }, 12);
+
+	CHECK(a->dominates(*a));
+	CHECK(a->dominates(*b));
+	CHECK(!b->dominates(*a));
+	CHECK(!a->dominates(*c));
+	// a job is certainly ready by 12 in d, but not in a
+	CHECK(a->dominates(*d));
+	CHECK(!d->dominates(*b));
+	CHECK(b->dominates(*d));
+
+	NP::Global::Schedule_node<dtime_t> n(2);
+	n.add_state(a);
+	// b is dropped without widening a
+	CHECK(n.merge_states(*b, false) == 1);
+	CHECK(n.states_size() == 1);
+	CHECK(n.get_first_state()->core_availability(2) == Interval<dtime_t>(5, 20));
+	// c is neither dominated nor contained in a
+	CHECK(n.merge_states(*c, true) == 0);
+
+	delete b;
+	delete c;
+	delete d;
+}
+
+TEST_CASE("[global] Merge only with states that can intersect the new state") {
+	NP::Global::Schedule_node<dtime_t> n(1);
+	for (dtime_t t = 0; t < 500; t += 10)
+		n.add_state(make_state({ Interval<dtime_t>(t, t + 2) }));
+
+	// intersects [300, 302] and [310, 312], but none of the other 48 states is compared with it
+	auto s = make_state({ Interval<dtime_t>(301, 311) });
+	CHECK(n.merge_states(*s, false, false, 2) == 2);
+	CHECK(n.states_size() == 49);
+	CHECK(n.number_of_merge_attempts() == 3);
+
+	// a state that becomes available after all others
+	auto late = make_state({ Interval<dtime_t>(600, 610) });
+	CHECK(n.merge_states(*late, false) == 0);
+	CHECK(n.number_of_merge_attempts() == 3);
+
+	// the merged state becomes available before x, and thus comes first
+	NP::Global::Schedule_node<dtime_t> m(2);
+	m.add_state(make_state({ Interval<dtime_t>(10, 12), Interval<dtime_t>(50, 52) }));
+	m.add_state(make_state({ Interval<dtime_t>(14, 16), Interval<dtime_t>(20, 22) }));
+	auto y = make_state({ Interval<dtime_t>(8, 15), Interval<dtime_t>(18, 30) });
+	CHECK(m.merge_states(*y, false) == 1);
+	CHECK(m.states_size() == 2);
+	CHECK(m.get_first_state()->core_availability() == Interval<dtime_t>(8, 16));
+	// hence it is found when looking for the states that become available from 8 on
+	auto z = make_state({ Interval<dtime_t>(9, 9), Interval<dtime_t>(25, 25) });
+	CHECK(m.merge_states(*z, true) == 1);
+	CHECK(m.states_size() == 2);
+
+	delete s;
+	delete late;
+	delete y;
+	delete z;
+}
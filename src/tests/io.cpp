@@ -1,9 +1,11 @@
 #include "doctest.h"
 
+#include <cstdio>
 #include <iostream>
 #include <sstream>
 
 #include "io.hpp"
+#include "job_set_file.hpp"
 
 const std::string one_line = "       920,          6,              50000.0,              50010.0,   23.227497252002234,    838.6724123730141,              60000.0,                    1";
 
@@ -193,3 +195,126 @@ TEST_CASE("[parser] valid precedence reference") {
 	// dummy check; real check is that previous line didn't throw an exception
 	CHECK(true);
 }
+
+TEST_CASE("[parser] job references are resolved by JobID") {
+	auto dag_in = std::istringstream(sequential_task_prec_file);
+	auto prec = NP::parse_precedence_file<dense_t>(dag_in);
+
+	auto in = std::istringstream(four_lines);
+	auto jobs = NP::parse_csv_job_file<dense_t>(in);
+	NP::Job_id_index job_ids(jobs);
+
+	for (NP::Job_index i = 0; i < jobs.size(); i++)
+		CHECK(job_ids.index_of(jobs[i].get_id()) == i);
+	CHECK(&job_ids.lookup(jobs, NP::JobID(2, 920)) == &jobs[1]);
+	CHECK(!job_ids.contains(NP::JobID(13, 3)));
+	REQUIRE_THROWS_AS(job_ids.index_of(NP::JobID(13, 3)), NP::InvalidJobReference);
+
+	NP::validate_prec_cstrnts<dense_t>(prec, job_ids);
+	CHECK(prec[0].get_fromIndex() == 0);
+	CHECK(prec[0].get_toIndex() == 1);
+	CHECK(prec[1].get_fromIndex() == 1);
+	CHECK(prec[1].get_toIndex() == 2);
+}
+
+const std::string moldable_jobs =
+"Task ID, Job ID, Arrival min, Arrival max, Cost, Deadline, Priority\r\n"
+"      1,      1,           0,          10, { 1:10:20; 2:6:12 }, 100, 1\r\n"
+"\r\n"
+"      1,      2,         100,         110, {1:5:8}, 200, 2\r\n"
+"      2,      1,           0,           0, 3, 4, 50, 3\r\n";
+
+TEST_CASE("[parser] moldable costs, blank lines and CRLF line endings") {
+	auto jobs = NP::parse_csv_job_file<dtime_t>(moldable_jobs.data(), moldable_jobs.data() + moldable_jobs.size());
+
+	REQUIRE(jobs.size() == 3);
+	CHECK(jobs[0].get_min_parallelism() == 1);
+	CHECK(jobs[0].get_max_parallelism() == 2);
+	CHECK(jobs[0].get_cost(1) == Interval<dtime_t>(10, 20));
+	CHECK(jobs[0].get_cost(2) == Interval<dtime_t>(6, 12));
+	CHECK(jobs[0].get_deadline() == 100);
+	CHECK(jobs[1].get_max_parallelism() == 1);
+	CHECK(jobs[1].get_cost(1) == Interval<dtime_t>(5, 8));
+	CHECK(jobs[1].get_priority() == 2);
+	CHECK(jobs[1].get_job_index() == 1);
+	CHECK(jobs[2].get_cost(1) == Interval<dtime_t>(3, 4));
+	CHECK(jobs[2].get_deadline() == 50);
+	CHECK(jobs[2].get_job_index() == 2);
+}
+
+TEST_CASE("[parser] parse errors report the line") {
+	const std::string bad_file = four_lines + "       920,          4,              foo, bar\n";
+	auto in = std::istringstream(bad_file);
+
+	try {
+		NP::parse_csv_job_file<dense_t>(in);
+		FAIL("no parse error");
+	} catch (std::ios_base::failure& ex) {
+		CHECK(std::string(ex.what()).find("line 5") != std::string::npos);
+	}
+
+	const std::string empty_costs = "header\n1, 1, 0, 0, {}, 10, 1\n";
+	REQUIRE_THROWS_AS(NP::parse_csv_job_file<dtime_t>(empty_costs.data(), empty_costs.data() + empty_costs.size()), std::ios_base::failure);
+}
+
+const std::string abort_file =
+"Task ID, Job ID, Trigger min, Trigger max, Cleanup min, Cleanup max\n"
+"      1,      2,          10,          12,           1,           3\n";
+
+TEST_CASE("[parser] abort file") {
+	auto in = std::istringstream(abort_file);
+
+	auto aborts = NP::parse_abort_file<dtime_t>(in);
+
+	REQUIRE(aborts.size() == 1);
+	CHECK(aborts[0].get_id() == NP::JobID(2, 1));
+	CHECK(aborts[0].earliest_trigger_time() == 10);
+	CHECK(aborts[0].latest_trigger_time() == 12);
+	CHECK(aborts[0].least_cleanup_cost() == 1);
+	CHECK(aborts[0].maximum_cleanup_cost() == 3);
+}
+
+TEST_CASE("[parser] binary job set round trip") {
+	const std::string path = "io_test.npjobs";
+	auto jobs = NP::parse_csv_job_file<dtime_t>(moldable_jobs.data(), moldable_jobs.data() + moldable_jobs.size());
+	std::vector<NP::Precedence_constraint<dtime_t>> prec{
+		{NP::JobID(2, 1), NP::JobID(1, 2), Interval<dtime_t>(0, 0)},
+		{NP::JobID(1, 1), NP::JobID(2, 1), Interval<dtime_t>(1, 2), false},
+		{NP::JobID(1, 1), NP::JobID(1, 2), Interval<dtime_t>(3, 4)}};
+	auto abort_in = std::istringstream(abort_file);
+	auto aborts = NP::parse_abort_file<dtime_t>(abort_in);
+
+	NP::Job_set_file::write<dtime_t>(path, jobs, prec, aborts);
+	NP::Job_set_file::Reader<dtime_t> file(path);
+	auto jobs2 = file.jobs();
+	auto prec2 = file.precedence_constraints();
+	auto aborts2 = file.abort_actions();
+
+	REQUIRE(jobs2.size() == jobs.size());
+	for (std::size_t i = 0; i < jobs.size(); i++) {
+		CHECK(jobs2[i].get_id() == jobs[i].get_id());
+		CHECK(jobs2[i].get_key() == jobs[i].get_key());
+		CHECK(jobs2[i].get_all_costs() == jobs[i].get_all_costs());
+		CHECK(jobs2[i].get_job_index() == i);
+	}
+
+	// grouped by predecessor
+	REQUIRE(prec2.size() == 3);
+	CHECK(prec2[0].get_fromID() == NP::JobID(1, 1));
+	CHECK(prec2[0].get_toID() == NP::JobID(2, 1));
+	CHECK(prec2[0].get_suspension() == Interval<dtime_t>(1, 2));
+	CHECK(!prec2[0].should_signal_at_completion());
+	CHECK(prec2[1].get_toID() == NP::JobID(1, 2));
+	CHECK(prec2[1].should_signal_at_completion());
+	CHECK(prec2[2].get_fromID() == NP::JobID(2, 1));
+
+	REQUIRE(aborts2.size() == 1);
+	CHECK(aborts2[0].get_id() == NP::JobID(2, 1));
+	CHECK(aborts2[0].latest_trigger_time() == 12);
+	CHECK(aborts2[0].maximum_cleanup_cost() == 3);
+
+	// the time model is part of the format
+	REQUIRE_THROWS_AS(NP::Job_set_file::Reader<dense_t>{path}, std::runtime_error);
+
+	std::remove(path.c_str());
+}
@@ -0,0 +1,51 @@
+#include "doctest.h"
+
+#include <vector>
+
+#include "global/node_table.hpp"
+
+using namespace NP::Global;
+
+struct Dummy_node {
+	int id;
+};
+
+TEST_CASE("[global] Node_table finds the most recent accepted node") {
+	Node_table<Dummy_node> table;
+	Dummy_node a{ 1 }, b{ 2 }, c{ 3 };
+	auto any = [](Dummy_node*) { return true; };
+
+	CHECK(table.find(5, 7, any) == nullptr);
+	table.insert(5, 7, &a);
+	table.insert(5, 7, &b);
+	// same key, but a different fingerprint
+	table.insert(5, 8, &c);
+	CHECK(table.size() == 3);
+
+	CHECK(table.find(5, 7, any) == &b);
+	CHECK(table.find(5, 8, any) == &c);
+	CHECK(table.find(6, 7, any) == nullptr);
+	CHECK(table.find(5, 7, [&](Dummy_node* n) { return n != &b; }) == &a);
+	CHECK(table.find(5, 7, [](Dummy_node*) { return false; }) == nullptr);
+}
+
+TEST_CASE("[global] Node_table clear and growth") {
+	Node_table<Dummy_node> table;
+	std::vector<Dummy_node> nodes(5000);
+	auto any = [](Dummy_node*) { return true; };
+
+	for (int depth = 0; depth < 3; depth++) {
+		for (int i = 0; i < 5000; i++) {
+			nodes[i].id = i;
+			// many nodes share a key, only the fingerprints differ
+			table.insert(i % 100, i, &nodes[i]);
+		}
+		CHECK(table.size() == 5000);
+		for (int i = 0; i < 5000; i++)
+			CHECK(table.find(i % 100, i, any) == &nodes[i]);
+
+		table.clear();
+		CHECK(table.size() == 0);
+		CHECK(table.find(0, 0, any) == nullptr);
+	}
+}
@@ -1,4 +1,3 @@
-#ifndef CONFIG_PARALLEL
 #include "doctest.h"
 #undef NDEBUG
 
@@ -207,6 +206,8 @@ TEST_CASE("Rating graph with hidden path") {
 	CHECK(rating_graph.nodes[0].get_rating() == 1.0);
 }
 
+// the node indices within a depth depend on the order in which the nodes are created
+#ifndef CONFIG_PARALLEL
 TEST_CASE("Rating graph basic test with early fork-join") {
 	Global::State_space<dtime_t>::Workload jobs{
 			Job<dtime_t>{0, Interval<dtime_t>(0,  1), Interval<dtime_t>(1, 2), 10, 10, 0, 0},
@@ -255,6 +256,8 @@ TEST_CASE("Rating graph basic test with early fork-join") {
 	CHECK(cut2.safe_job == 1);
 }
 
+#endif
+
 TEST_CASE("Rating graph sanity 1") {
 	Global::State_space<dtime_t>::Workload jobs {
 			Job<dtime_t>{0, Interval<dtime_t>(100, 100), Interval<dtime_t>(100, 200), 1100, 1, 0, 0},
@@ -360,4 +363,27 @@ TEST_CASE("Rating graph with precedence constraints") {
 	CHECK(rating_graph.nodes[node_after02].get_rating() == 0.0);
 }
 
-#endif
+TEST_CASE("Rating graph numbering") {
+	Global::State_space<dtime_t>::Workload jobs;
+	for (unsigned int i = 0; i < 16; i++)
+		jobs.push_back(Job<dtime_t>{i, Interval<dtime_t>(10 * (i / 4), 10 * (i / 4) + 15), Interval<dtime_t>(2, 6), 40 + 10 * (i / 4), i % 3, i, i});
+	auto problem = Scheduling_problem<dtime_t>(jobs, 2);
+
+	Reconfiguration::Rating_graph rating_graph;
+	Reconfiguration::Agent_rating_graph<dtime_t>::generate(problem, rating_graph, true);
+	REQUIRE(rating_graph.nodes.size() > 100);
+
+	// every child is numbered after its parent, and the nodes are numbered depth by depth
+	for (const auto &edge : rating_graph.edges)
+		CHECK(edge.get_parent_node_index() < edge.get_child_node_index());
+	const auto depth_mapping = rating_graph.create_depth_mapping();
+	for (size_t node_index = 1; node_index < rating_graph.nodes.size(); node_index++)
+		CHECK(depth_mapping[node_index - 1] <= depth_mapping[node_index]);
+
+	// every node but the root is reached by an edge
+	std::vector<bool> reached(rating_graph.nodes.size(), false);
+	for (const auto &edge : rating_graph.edges)
+		reached[edge.get_child_node_index()] = true;
+	for (size_t node_index = 1; node_index < rating_graph.nodes.size(); node_index++)
+		CHECK(reached[node_index]);
+}
@@ -0,0 +1,68 @@
+#include "doctest.h"
+
+#include <vector>
+
+#include "global/sorted_states.hpp"
+
+using namespace NP::Global;
+
+namespace {
+	// only what Sorted_states needs of a state
+	struct Fake_state {
+		long eft;
+		int id;
+
+		long earliest_finish_time() const
+		{
+			return eft;
+		}
+	};
+}
+
+static std::vector<int> ids(const Sorted_states<Fake_state>& states)
+{
+	std::vector<int> result;
+	for (const Fake_state* s : states)
+		result.push_back(s->id);
+	return result;
+}
+
+TEST_CASE("[sorted states] Insert in order of earliest finish time") {
+	// more states than fit inline, such that the references move to the heap
+	std::vector<Fake_state> pool = { {5, 0}, {1, 1}, {3, 2}, {5, 3}, {0, 4}, {3, 5}, {9, 6}, {1, 7}, {5, 8} };
+	Sorted_states<Fake_state> states;
+	CHECK(states.empty());
+	for (Fake_state& s : pool)
+		states.insert(&s);
+
+	CHECK(states.size() == pool.size());
+	// ties stay in the order in which the states were added
+	CHECK(ids(states) == std::vector<int>{ 4, 1, 7, 2, 5, 0, 3, 8, 6 });
+	CHECK((*states.lower_bound(3L))->id == 2);
+	CHECK((*states.lower_bound(4L))->id == 0);
+	CHECK(states.lower_bound(10L) == states.end());
+
+	auto next = states.erase(states.lower_bound(3L));
+	CHECK((*next)->id == 5);
+	CHECK(ids(states) == std::vector<int>{ 4, 1, 7, 5, 0, 3, 8, 6 });
+
+	// state 8 becomes available at 1: it moves after the other states available at 1
+	pool[8].eft = 1;
+	states.restore_order(states.end() - 2);
+	CHECK(ids(states) == std::vector<int>{ 4, 1, 7, 8, 5, 0, 3, 6 });
+}
+
+TEST_CASE("[sorted states] Inline storage") {
+	std::vector<Fake_state> pool = { {2, 0}, {1, 1}, {2, 2} };
+	Sorted_states<Fake_state> states;
+	for (Fake_state& s : pool)
+		states.insert(&s);
+	CHECK(ids(states) == std::vector<int>{ 1, 0, 2 });
+
+	states.erase(states.begin());
+	states.erase(states.end() - 1);
+	CHECK(ids(states) == std::vector<int>{ 0 });
+	states.erase(states.begin());
+	CHECK(states.empty());
+	CHECK(states.begin() == states.end());
+}